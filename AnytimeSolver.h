@@ -0,0 +1,520 @@
+// Anytime Solver: A quick first solution for large boards that keeps getting shorter
+#ifndef ANYTIMESOLVER_H
+#define ANYTIMESOLVER_H
+
+#include <cstring>
+#include <chrono>
+#include <atomic>
+#include "Solver.h"
+using namespace std;
+
+#define ANYTIME_NODES (1 << 18)     // Boards the arena can hold (about 23 MB)
+#define ANYTIME_PHASES 8            // Searches with falling weights (see anytimeWeights)
+#define ANYTIME_CHECK_NODES 256     // Expansions between clock checks
+#define ANYTIME_NO_BOUND 1000000    // "Infinite" f value
+#define ANYTIME_STAGE_STATES (SIMD_MAX_CELLS * SIMD_MAX_CELLS * SIMD_MAX_CELLS)   // Positions one construction step can visit
+
+// Weight on the Manhattan distance in each phase, in tenths (10 = plain A*)
+const int anytimeWeights[ANYTIME_PHASES] = {1000, 100, 50, 30, 20, 15, 12, 10};
+
+// Restarting weighted A* in a fixed-size arena
+// - The first phase expands nodes by g + 100 * h (almost greedy); it usually finds a
+//   solution within a few ms but on some boards takes seconds, so construct() gives a
+//   first solution at once and the search only has to beat it
+// - Every later phase starts over from the start board with a lower weight and
+//   prunes every node with g + h >= best length, so each solution is shorter
+// - All nodes, the open list and the duplicate table are allocated once; a phase
+//   starts with an empty arena, and when it is full new boards are dropped
+// The optimal length is at least lowerBound(); the solution is optimal once they meet
+class AnytimeSolver {
+    // One searched board (the board itself is in boards[index * cells])
+    struct Node {
+        unsigned long long hash;
+        int parent;             // -1 for the start board
+        short g;                // Moves from the start
+        short h;                // Manhattan distance
+        unsigned char blank;
+        unsigned char move;     // Move code that led here
+        bool waiting;           // Has a current (not stale) open list entry
+    };
+
+    // Open list entry (stale once the node's g has been lowered since)
+    struct OpenEntry {
+        int key;
+        int g;
+        int node;
+    };
+
+    int capacity;
+    Node* nodes;
+    unsigned char* boards;
+    OpenEntry* open;            // Binary heap on key (2 entries per node, for reopened nodes)
+    int* table;                 // Open addressing hash table of node indexes (-1 = empty)
+    int tableMask;
+    unsigned long long zobrist[SIMD_MAX_CELLS][SIMD_MAX_CELLS];
+
+    BoardTarget target;
+    unsigned char startBoard[SIMD_MAX_CELLS];
+    int cells;
+    int phase;                  // Index into anytimeWeights
+    int provenBound;            // Lower bound proven by finished phases
+    int nodeCount;
+    int openCount;
+    int droppedBound;           // Smallest g + h of a board that did not fit
+    int waitingByF[SOLVE_MAX_LENGTH + 1];   // Current open list entries by g + h
+    int minWaitingF;            // No current entry has a smaller g + h
+    int bestLength;             // Shortest solution so far (ANYTIME_NO_BOUND if none)
+    unsigned char bestPath[SOLVE_MAX_LENGTH];
+    long long expanded;
+    unsigned char* stageMove;   // Construction: move code that first reached each position (255 = not yet)
+    int* stageQueue;            // Construction: breadth-first queue of positions
+
+    static bool before(const OpenEntry& a, const OpenEntry& b) {
+        return a.key < b.key || (a.key == b.key && a.g > b.g);     // Deeper first on ties
+    }
+
+    void pushOpen(const OpenEntry& entry) {
+        int i = openCount++;
+        while (i > 0 && before(entry, open[(i - 1) / 2])) {
+            open[i] = open[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        open[i] = entry;
+    }
+
+    OpenEntry popOpen() {
+        OpenEntry top = open[0];
+        OpenEntry last = open[--openCount];
+        int i = 0;
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= openCount) break;
+            if (child + 1 < openCount && before(open[child + 1], open[child])) child++;
+            if (!before(open[child], last)) break;
+            open[i] = open[child];
+            i = child;
+        }
+        open[i] = last;
+        return top;
+    }
+
+    // Node holding a board, or -1 (slot receives the table position for an insert)
+    int findNode(unsigned long long hash, const unsigned char* board, int& slot) {
+        int i = (int)(hash & tableMask);
+        while (table[i] != -1) {
+            int n = table[i];
+            if (nodes[n].hash == hash && memcmp(boards + (long long)n * cells, board, cells) == 0) {
+                slot = i;
+                return n;
+            }
+            i = (i + 1) & tableMask;
+        }
+        slot = i;
+        return -1;
+    }
+
+    // Remember a board that could not be kept (the bound must still cover it)
+    void drop(int f) {
+        if (f < droppedBound) droppedBound = f;
+    }
+
+    // Add a board to the open list (new or reached by a shorter path)
+    void addBoard(const unsigned char* board, unsigned long long hash, int g, int h, int blank, int parent, int move) {
+        if (g + h >= bestLength) return;        // Cannot lead to a shorter solution
+        if (g + h > SOLVE_MAX_LENGTH) return;   // Too long to store
+
+        int slot;
+        int n = findNode(hash, board, slot);
+        if (n >= 0) {
+            if (nodes[n].g <= g) return;        // Already reached at least as fast
+            if (nodes[n].waiting) waitingByF[nodes[n].g + h]--;     // Its entry goes stale
+        } else {
+            if (nodeCount == capacity) {
+                drop(g + h);
+                return;
+            }
+            n = nodeCount++;
+            memcpy(boards + (long long)n * cells, board, cells);
+            nodes[n].hash = hash;
+            nodes[n].h = h;
+            nodes[n].blank = blank;
+            table[slot] = n;
+        }
+        nodes[n].g = g;
+        nodes[n].parent = parent;
+        nodes[n].move = move;
+        nodes[n].waiting = false;
+
+        if (openCount == 2 * capacity) {
+            drop(g + h);
+            return;
+        }
+        nodes[n].waiting = true;
+        waitingByF[g + h]++;
+        if (g + h < minWaitingF) minWaitingF = g + h;
+        OpenEntry entry;
+        entry.key = 10 * g + anytimeWeights[phase] * h;
+        entry.g = g;
+        entry.node = n;
+        pushOpen(entry);
+    }
+
+    // Store the path to a goal node as the new best solution
+    void recordSolution(int n) {
+        int length = nodes[n].g;
+        for (int i = length - 1; i >= 0; i--) {
+            bestPath[i] = nodes[n].move;
+            n = nodes[n].parent;
+        }
+        bestLength = length;
+    }
+
+    // Empty the arena and search again from the start board with the current weight
+    void startPhase() {
+        nodeCount = 0;
+        openCount = 0;
+        droppedBound = ANYTIME_NO_BOUND;
+        memset(table, -1, sizeof(int) * (tableMask + 1));
+        memset(waitingByF, 0, sizeof(waitingByF));
+        minWaitingF = ANYTIME_NO_BOUND;
+
+        unsigned long long hash = 0;
+        int blank = 0;
+        for (int c = 0; c < cells; c++) {
+            hash ^= zobrist[c][startBoard[c]];
+            if (startBoard[c] == 0) blank = c;
+        }
+        int misplaced, distance;
+        evaluateBoard(target, startBoard, misplaced, distance);
+        if (distance > provenBound) provenBound = distance;
+        addBoard(startBoard, hash, 0, distance, blank, -1, 4);
+    }
+
+    // TILE-BY-TILE CONSTRUCTION
+    // The target is reached in steps that each put one or two more tiles in place and
+    // then leave them there: row 0 left to right, column 0 top to bottom, row 1, column 1, ...
+    // and finally the bottom right 2 x 2 corner. The last two tiles of a row or column go
+    // in together (one at a time would need to move the first one again).
+    // Each step is a breadth-first search over the positions of only its own tiles and
+    // the empty space, so it is small and always finds a way for a solvable board.
+    // The order needs the empty space in the bottom right corner, so the target is first
+    // changed to have it there and the empty space is moved back at the end.
+
+    // Breadth-first search moving the tiles of goal's goalCells into place without
+    // touching frozen cells; plays the moves on board and appends them to path
+    // Returns false if there is no way or the path gets too long
+    bool placeTiles(const unsigned char* goal, const int* goalCells, int count, const bool* frozen,
+                    unsigned char* board, int& blank, unsigned char* path, int& length) {
+        int gridSize = target.gridSize;
+        int freeCells[SIMD_MAX_CELLS];
+        int index[SIMD_MAX_CELLS];      // Index of each free cell in freeCells (-1 = frozen)
+        int freeCount = 0;
+        for (int c = 0; c < cells; c++) {
+            index[c] = frozen[c] ? -1 : freeCount;
+            if (!frozen[c]) freeCells[freeCount++] = c;
+        }
+
+        // A position is the free cell index of the empty space and of each tile, in base freeCount
+        int states = freeCount;
+        for (int t = 0; t < count; t++) states *= freeCount;
+        if (states > ANYTIME_STAGE_STATES) return false;
+
+        int where[3];
+        int goalTiles = 0;
+        for (int t = count - 1; t >= 0; t--) {
+            for (int c = 0; c < cells; c++) {
+                if (board[c] == goal[goalCells[t]]) where[t] = c;
+            }
+            goalTiles = goalTiles * freeCount + index[goalCells[t]];
+        }
+        int startTiles = 0;
+        for (int t = count - 1; t >= 0; t--) startTiles = startTiles * freeCount + index[where[t]];
+        int start = startTiles * freeCount + index[blank];
+        if (startTiles == goalTiles) return true;
+
+        memset(stageMove, 255, states);
+        stageMove[start] = 4;
+        int head = 0, tail = 0;
+        int found = -1;
+        stageQueue[tail++] = start;
+        while (head < tail && found < 0) {
+            int state = stageQueue[head++];
+            int from = freeCells[state % freeCount];
+            int rest = state / freeCount;
+            for (int t = 0; t < count; t++) {
+                where[t] = freeCells[rest % freeCount];
+                rest /= freeCount;
+            }
+
+            for (int code = 0; code < 4; code++) {
+                int next = blankAfterMove(from, code, gridSize);
+                if (next < 0 || frozen[next]) continue;
+
+                int tiles = 0;
+                for (int t = count - 1; t >= 0; t--) tiles = tiles * freeCount + index[where[t] == next ? from : where[t]];
+                int nextState = tiles * freeCount + index[next];
+                if (stageMove[nextState] != 255) continue;
+                stageMove[nextState] = code;
+                if (tiles == goalTiles) {
+                    found = nextState;
+                    break;
+                }
+                stageQueue[tail++] = nextState;
+            }
+        }
+        if (found < 0) return false;
+
+        // Walk back to the start: the empty space came from the opposite direction
+        // and a tile on the cell it came from slid there from its current cell
+        auto previous = [&](int state) {
+            int at = freeCells[state % freeCount];
+            int back = blankAfterMove(at, stageMove[state] ^ 1, gridSize);
+            int tiles = 0;
+            int rest = state / freeCount;
+            int place = 1;
+            for (int t = 0; t < count; t++) {
+                int cell = freeCells[rest % freeCount];
+                rest /= freeCount;
+                tiles += index[cell == back ? at : cell] * place;
+                place *= freeCount;
+            }
+            return tiles * freeCount + index[back];
+        };
+        int moves = 0;
+        for (int state = found; stageMove[state] != 4; state = previous(state)) moves++;
+        if (length + moves > SOLVE_MAX_LENGTH) return false;
+
+        int i = length + moves;
+        for (int state = found; stageMove[state] != 4; state = previous(state)) path[--i] = stageMove[state];
+
+        for (i = length; i < length + moves; i++) {
+            int next = blankAfterMove(blank, path[i], gridSize);
+            board[blank] = board[next];
+            board[next] = 0;
+            blank = next;
+        }
+        length += moves;
+        return true;
+    }
+
+    // A phase ended: keep what it proved and move on to the next weight
+    void endPhase() {
+        int bound = lowerBound();
+        if (bound > provenBound) provenBound = bound;
+        if (phase + 1 < ANYTIME_PHASES) {
+            phase++;
+            startPhase();
+        }
+    }
+
+public:
+    AnytimeSolver(int capacity = ANYTIME_NODES) : capacity(capacity) {
+        nodes = new Node[capacity];
+        boards = new unsigned char[(long long)capacity * SIMD_MAX_CELLS];
+        open = new OpenEntry[2 * capacity];
+
+        int tableSize = 1;
+        while (tableSize < 2 * capacity) tableSize *= 2;
+        table = new int[tableSize];
+        tableMask = tableSize - 1;
+
+        // Random keys for incremental board hashes (fixed seed: runs are repeatable)
+        unsigned long long x = 0x9E3779B97F4A7C15ULL;
+        for (int c = 0; c < SIMD_MAX_CELLS; c++) {
+            for (int t = 0; t < SIMD_MAX_CELLS; t++) {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                zobrist[c][t] = x;
+            }
+        }
+        stageMove = new unsigned char[ANYTIME_STAGE_STATES];
+        stageQueue = new int[ANYTIME_STAGE_STATES];
+        nodeCount = 0;
+        openCount = 0;
+        bestLength = ANYTIME_NO_BOUND;
+    }
+
+    ~AnytimeSolver() {
+        delete[] nodes;
+        delete[] boards;
+        delete[] open;
+        delete[] table;
+        delete[] stageMove;
+        delete[] stageQueue;
+    }
+
+    // Begin a new search (board must be solvable and at most SIMD_MAX_CELLS cells)
+    void start(const BoardTarget& goal, const unsigned char* board) {
+        target = goal;
+        cells = goal.cells;
+        memcpy(startBoard, board, cells);
+        phase = 0;
+        provenBound = 0;
+        bestLength = ANYTIME_NO_BOUND;
+        expanded = 0;
+        startPhase();
+    }
+
+    // Keep searching for up to milliseconds
+    // If ticket is given it also stops early once *ticket != expectedTicket
+    // Returns true if a shorter solution was found
+    bool improve(int milliseconds, const atomic<unsigned int>* ticket = NULL, unsigned int expectedTicket = 0) {
+        chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::milliseconds(milliseconds);
+        int lengthBefore = bestLength;
+        unsigned char board[SIMD_MAX_CELLS];
+
+        while (true) {
+            if (openCount == 0) {
+                if (phase + 1 == ANYTIME_PHASES) break;     // Last phase searched everything
+                endPhase();
+                continue;
+            }
+            if (expanded % ANYTIME_CHECK_NODES == 0) {
+                if (chrono::steady_clock::now() >= deadline) break;
+                if (ticket != NULL && ticket -> load(memory_order_relaxed) != expectedTicket) break;
+            }
+
+            OpenEntry entry = popOpen();
+            Node& node = nodes[entry.node];
+            if (entry.g != node.g || !node.waiting) continue;   // Reached by a shorter path since
+            node.waiting = false;
+            waitingByF[node.g + node.h]--;
+            if (node.g + node.h >= bestLength) continue;
+
+            if (node.h == 0) {
+                recordSolution(entry.node);
+                if (phase + 1 < ANYTIME_PHASES) endPhase(); // Try again with a lower weight
+                continue;
+            }
+            expanded++;
+
+            int parent = entry.node;
+            int g = node.g;
+            int h = node.h;
+            int blank = node.blank;
+            int lastMove = node.move;
+            unsigned long long hash = node.hash;
+            memcpy(board, boards + (long long)parent * cells, cells);
+
+            for (int code = 0; code < 4; code++) {
+                if (code == (lastMove ^ 1)) continue;
+                int next = blankAfterMove(blank, code, target.gridSize);
+                if (next < 0) continue;
+
+                int tile = board[next];
+                int childH = h + manhattanChange(target, tile, next, blank);
+                unsigned long long childHash = hash ^ zobrist[blank][0] ^ zobrist[next][tile]
+                                                    ^ zobrist[blank][tile] ^ zobrist[next][0];
+                board[blank] = tile;
+                board[next] = 0;
+                addBoard(board, childHash, g + 1, childH, next, parent, code);
+                board[next] = tile;
+                board[blank] = 0;
+            }
+        }
+        return bestLength < lengthBefore;
+    }
+
+    // Build the tile-by-tile solution (see placeTiles) and keep it if it is the shortest so far
+    // Takes well under a millisecond on 5x5; returns true if it became the best solution
+    bool construct() {
+        int gridSize = target.gridSize;
+        unsigned char board[SIMD_MAX_CELLS];
+        memcpy(board, startBoard, cells);
+        int blank = 0;
+        while (board[blank] != 0) blank++;
+
+        // Target with the empty space moved down and then right into the corner
+        unsigned char goal[SIMD_MAX_CELLS];
+        memcpy(goal, target.tiles, cells);
+        unsigned char corner[2 * SIMD_MAX_CELLS];
+        int cornerMoves = 0;
+        int goalBlank = target.goalRow[0] * gridSize + target.goalCol[0];
+        while (goalBlank != cells - 1) {
+            int code = goalBlank / gridSize < gridSize - 1 ? 0 : 2;
+            int next = blankAfterMove(goalBlank, code, gridSize);
+            goal[goalBlank] = goal[next];
+            goal[next] = 0;
+            goalBlank = next;
+            corner[cornerMoves++] = code;
+        }
+
+        bool frozen[SIMD_MAX_CELLS] = {false};
+        unsigned char path[SOLVE_MAX_LENGTH];
+        int length = 0;
+        int goalCells[3];
+        for (int layer = 0; layer < gridSize - 2; layer++) {
+            for (int col = layer; col < gridSize; col++) {
+                int count = col == gridSize - 2 ? 2 : 1;
+                for (int t = 0; t < count; t++) goalCells[t] = layer * gridSize + col + t;
+                if (!placeTiles(goal, goalCells, count, frozen, board, blank, path, length)) return false;
+                for (int t = 0; t < count; t++) frozen[goalCells[t]] = true;
+                col += count - 1;
+            }
+            for (int row = layer + 1; row < gridSize; row++) {
+                int count = row == gridSize - 2 ? 2 : 1;
+                for (int t = 0; t < count; t++) goalCells[t] = (row + t) * gridSize + layer;
+                if (!placeTiles(goal, goalCells, count, frozen, board, blank, path, length)) return false;
+                for (int t = 0; t < count; t++) frozen[goalCells[t]] = true;
+                row += count - 1;
+            }
+        }
+        goalCells[0] = cells - gridSize - 2;
+        goalCells[1] = cells - gridSize - 1;
+        goalCells[2] = cells - 2;
+        if (!placeTiles(goal, goalCells, 3, frozen, board, blank, path, length)) return false;
+
+        // Move the empty space back to where the real target has it
+        if (length + cornerMoves > SOLVE_MAX_LENGTH) return false;
+        for (int i = cornerMoves - 1; i >= 0; i--) {
+            int code = corner[i] ^ 1;
+            int next = blankAfterMove(blank, code, gridSize);
+            board[blank] = board[next];
+            board[next] = 0;
+            blank = next;
+            path[length++] = code;
+        }
+        if (memcmp(board, target.tiles, cells) != 0 || length >= bestLength) return false;
+
+        memcpy(bestPath, path, length);
+        bestLength = length;
+        return true;
+    }
+
+    bool hasSolution() {
+        return bestLength != ANYTIME_NO_BOUND;
+    }
+
+    // Moves in the best solution so far (path needs room for SOLVE_MAX_LENGTH move codes)
+    int getSolution(unsigned char* path) {
+        if (!hasSolution()) return SOLVE_GAVE_UP;
+        memcpy(path, bestPath, bestLength);
+        return bestLength;
+    }
+
+    // The optimal solution has at least this many moves
+    // (smallest g + h still waiting or dropped in this phase)
+    // Children never have a smaller g + h than their parent (the Manhattan distance changes
+    // by one per move), so minWaitingF only moves up within a phase: amortized O(1)
+    int lowerBound() {
+        while (minWaitingF <= SOLVE_MAX_LENGTH && waitingByF[minWaitingF] == 0) minWaitingF++;
+        if (minWaitingF > SOLVE_MAX_LENGTH) minWaitingF = ANYTIME_NO_BOUND;
+
+        int bound = bestLength < droppedBound ? bestLength : droppedBound;
+        if (minWaitingF < bound) bound = minWaitingF;
+        return bound > provenBound ? bound : provenBound;
+    }
+
+    // Nothing left to search: the solution is optimal or the arena is too small to improve it
+    bool isFinished() {
+        if (phase + 1 == ANYTIME_PHASES && openCount == 0) return true;
+        return hasSolution() && lowerBound() >= bestLength;
+    }
+
+    long long getExpanded() {
+        return expanded;
+    }
+};
+
+#endif
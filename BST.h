@@ -7,8 +7,13 @@
 #include <iostream>
 #include <iomanip>
 #include <cstdlib>
+#include <vector>
+#include <unordered_map>
+#include "NodePool.h"
 using namespace std;
 
+#define LEADERBOARD_KEEP 100    // Scores kept per difficulty (or per difficulty and theme)
+
 // Color Codes
 #define C "\033[0m"
 #define Y "\033[38;5;226m"
@@ -20,86 +25,71 @@ struct BSTNode {
     int moves;           
     int difficulty;      
     string theme;        
+    int sequence;         // Insert order (breaks ties: the older score ranks higher)
+    int height;           // Levels in this subtree (for AVL balancing)
     BSTNode* right;       // right child (better scores)
     BSTNode* left;      // left child (worse scores)
 };
 
+// Scores kept for one difficulty (or difficulty and theme)
+// Max-heap on rank, so the worst kept score is always worst[0]
+struct ScoreGroup {
+    vector<BSTNode*> worst;
+};
+
 class BST {
     BSTNode* root;    
     int totalScores;
+    NodePool<BSTNode, 256> pool;      // Node storage, freed all at once with the tree
+    int keepPerGroup;
+    bool groupByTheme;
+    int nextSequence;
+    unordered_map<string, ScoreGroup> groups;
+    string lazyFile;                  // Score file opened lazily and not read yet ("" if none)
 
 public:
-    BST() : root(NULL), totalScores(0) {}
+    // Keeps the best keepPerGroup scores of each difficulty (of each difficulty
+    // and theme if groupByTheme), so memory and file size stop growing
+    BST(int keepPerGroup = LEADERBOARD_KEEP, bool groupByTheme = false)
+        : root(NULL), totalScores(0), keepPerGroup(keepPerGroup), groupByTheme(groupByTheme), nextSequence(0) {}
 
-    ~BST() {
-        destroyTree(root);
-    }
+    // Nodes live in this tree's pool, so a tree cannot be copied
+    BST(const BST&) = delete;
+    BST& operator=(const BST&) = delete;
     
     // Add a new score to leaderboard
     // Sorts by: difficulty then moves
-    void insert(string name, int moves, int difficulty, string theme) {
-        if (root == NULL) {
-            root = new BSTNode();
-            root -> name = name;
-            root -> moves = moves;
-            root -> difficulty = difficulty;
-            root -> theme = theme;
-            root -> right = NULL;
-            root -> left = NULL;
-            totalScores++;
-            return;
-        }
-
-        BSTNode* current = root;
-        while (true) {
-            bool goRight = false;
-            
-            if (difficulty > current -> difficulty) {
-                goRight = true;
-            } else if (difficulty == current -> difficulty && moves < current -> moves) {
-                goRight = true;
-            }
-
-            if (goRight) {
-                if (current -> right == NULL) {
-                    current -> right = new BSTNode();
-                    current -> right -> name = name;
-                    current -> right -> moves = moves;
-                    current -> right -> difficulty = difficulty;
-                    current -> right -> theme = theme;
-                    current -> right -> right = NULL;
-                    current -> right -> left = NULL;
-                    totalScores++;
-                    return;
-                } else {
-                    current = current -> right;
-                }
-            } else {
-                if (current -> left == NULL) {
-                    current -> left = new BSTNode();
-                    current -> left -> name = name;
-                    current -> left -> moves = moves;
-                    current -> left -> difficulty = difficulty;
-                    current -> left -> theme = theme;
-                    current -> left -> right = NULL;
-                    current -> left -> left = NULL;
-                    totalScores++;
-                    return;
-                } else {
-                    current = current -> left;
-                }
-            }
-        }
+    // Returns false if the score is not better than the worst one kept for its group;
+    // otherwise it is added and, if the group is full, that worst score is removed
+    // (O(log K): the tree is balanced and holds at most K scores per group)
+    bool insert(string name, int moves, int difficulty, string theme) {
+        loadLazyFile();
+        return insertScore(name, moves, difficulty, theme, nextSequence++);
     }
     
     // Display top 10 scores in order
     void display() {
-        int rank = 1; 
-        displayInOrder(root, rank);
+        vector<BSTNode> top;
+        topScores(10, 0, top);
+        for (int i = 0; i < (int)top.size(); i++) {
+            displayRow(top[i], i + 1);
+        }
+    }
+
+    // Best count scores, best first (only of one difficulty unless difficulty is 0)
+    // A lazily opened file is read only up to the last score needed
+    void topScores(int count, int difficulty, vector<BSTNode>& out) {
+        out.clear();
+        if (lazyFile != "" && streamTop(lazyFile, count, difficulty, out)) return;
+
+        out.clear();
+        loadLazyFile();
+        collectTop(root, count, difficulty, out);
     }
     
     // Save all scores to file
     void saveToFile(string filename) {
+        loadLazyFile();
         ofstream file(filename.c_str());
         if (file.is_open()) {
             saveToFileHelper(root, file);
@@ -107,31 +97,24 @@ public:
         }
     }
     
-    // Load scores from file
+    // Use a score file without reading it yet (for a quick leaderboard screen)
+    // display() reads just the top of the file, since saveToFile() writes it
+    // best first; the first insert, save or getSize() loads all of it
+    void openLazy(string filename) {
+        lazyFile = filename;
+    }
+
+    // Load scores from file (only the best scores of each group are kept)
+    // Scores are inserted as they are read; saveToFile() writes best first, so once a
+    // group is full the rest of its lines are rejected without storing anything
+    // (ties keep their file order through the sequence numbers)
     void loadFromFile(string filename) {
         ifstream file(filename.c_str());
         if (file.is_open()) {
             string line;
+            BSTNode entry;
             while (getline(file, line)) {
-                if (line.empty()) continue;
-
-                string name = "", moves = "", difficulty = "", theme = "";
-                int part = 0;
-
-                for (int i = 0; i < line.length(); i++) {
-                    if (line[i] == '|') {
-                        part++;
-                    } else {
-                        if (part == 0) name += line[i];
-                        else if (part == 1) moves += line[i];
-                        else if (part == 2) difficulty += line[i];
-                        else if (part == 3) theme += line[i];
-                    }
-                }
-
-                if (!name.empty() && !moves.empty()) {
-                    insert(name, atoi(moves.c_str()), atoi(difficulty.c_str()), theme);
-                }
+                if (parseScore(line, entry)) insertScore(entry.name, entry.moves, entry.difficulty, entry.theme, nextSequence++);
             }
             file.close();
         }
@@ -139,48 +122,277 @@ public:
     
     // Check if leaderboard is empty
     bool isEmpty() {
+        if (lazyFile != "") {
+            vector<BSTNode> top;
+            topScores(1, 0, top);
+            return top.empty();
+        }
         return root == NULL;
     }
     
     // Get total number of scores
     int getSize() {
+        loadLazyFile();
         return totalScores;
     }
 
 private:
-    // Recursively display scores in-order
-    void displayInOrder(BSTNode* node, int& rank) {
-        if (node == NULL || rank > 10) return;
+    // Read a lazily opened file completely (does nothing if there is none)
+    void loadLazyFile() {
+        if (lazyFile == "") return;
+        string filename = lazyFile;
+        lazyFile = "";
+        loadFromFile(filename);
+    }
+
+    // Split a "name|moves|difficulty|theme" line (returns false for blank or broken lines)
+    static bool parseScore(const string& line, BSTNode& entry) {
+        string name = "", moves = "", difficulty = "", theme = "";
+        int part = 0;
+
+        for (int i = 0; i < (int)line.length(); i++) {
+            if (line[i] == '|') {
+                part++;
+            } else {
+                if (part == 0) name += line[i];
+                else if (part == 1) moves += line[i];
+                else if (part == 2) difficulty += line[i];
+                else if (part == 3) theme += line[i];
+            }
+        }
+        if (name.empty() || moves.empty()) return false;
+
+        entry.name = name;
+        entry.moves = atoi(moves.c_str());
+        entry.difficulty = atoi(difficulty.c_str());
+        entry.theme = theme;
+        return true;
+    }
+
+    // Read the best scores from the top of a file written by saveToFile()
+    // Stops after count scores (or once past the difficulty asked for)
+    // Returns false if the lines read are not in rank order (the caller loads the file instead)
+    bool streamTop(string filename, int count, int difficulty, vector<BSTNode>& out) {
+        ifstream file(filename.c_str());
+        if (!file.is_open()) return true;
+
+        string line;
+        BSTNode entry, previous;
+        bool first = true;
+        entry.sequence = previous.sequence = 0;
+        while ((int)out.size() < count && getline(file, line)) {
+            if (!parseScore(line, entry)) continue;
+            if (!first && isBetter(&entry, &previous)) return false;
+            first = false;
+            previous = entry;
+
+            if (difficulty != 0 && entry.difficulty < difficulty) break;     // The rest is easier
+            if (difficulty == 0 || entry.difficulty == difficulty) out.push_back(entry);
+        }
+        return true;
+    }
+
+    // Best scores in the tree (right subtree first), stopping once out is full
+    void collectTop(BSTNode* node, int count, int difficulty, vector<BSTNode>& out) {
+        if (node == NULL || (int)out.size() >= count) return;
+
+        collectTop(node -> right, count, difficulty, out);
+        if ((int)out.size() < count && (difficulty == 0 || node -> difficulty == difficulty)) {
+            out.push_back(*node);
+        }
+        collectTop(node -> left, count, difficulty, out);
+    }
+
+    // Group a score is kept in
+    string groupKey(int difficulty, string theme) {
+        if (groupByTheme) return to_string(difficulty) + "|" + theme;
+        return to_string(difficulty);
+    }
+
+    // Rank order within one difficulty: fewer moves first, then older scores first
+    static bool ranksAbove(int moves, int sequence, BSTNode* other) {
+        return moves < other -> moves || (moves == other -> moves && sequence < other -> sequence);
+    }
+
+    // Tree order: higher difficulty first, then rank (goes right if better)
+    static bool isBetter(BSTNode* node, BSTNode* other) {
+        if (node -> difficulty != other -> difficulty) return node -> difficulty > other -> difficulty;
+        return ranksAbove(node -> moves, node -> sequence, other);
+    }
+
+    // Heap helpers (parent must rank below its children)
+    void siftUp(ScoreGroup& group, int i) {
+        while (i > 0 && isBetter(group.worst[(i - 1) / 2], group.worst[i])) {
+            swap(group.worst[i], group.worst[(i - 1) / 2]);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void siftDown(ScoreGroup& group, int i) {
+        int count = group.worst.size();
+        while (true) {
+            int worst = i;
+            int child = 2 * i + 1;
+            if (child < count && isBetter(group.worst[worst], group.worst[child])) worst = child;
+            if (child + 1 < count && isBetter(group.worst[worst], group.worst[child + 1])) worst = child + 1;
+            if (worst == i) return;
+            swap(group.worst[i], group.worst[worst]);
+            i = worst;
+        }
+    }
+
+    // AVL BALANCING
+    // Equal scores get ever larger sequence numbers and always go the same way, and a
+    // saved file is read back in rank order, so without balancing the tree turns into a
+    // list. Every subtree's heights differ by at most one, so insert and remove are O(log n)
+
+    static int height(BSTNode* node) {
+        return node == NULL ? 0 : node -> height;
+    }
+
+    static void updateHeight(BSTNode* node) {
+        int left = height(node -> left), right = height(node -> right);
+        node -> height = 1 + (left > right ? left : right);
+    }
+
+    // Lift the right child above node (returns the new subtree root)
+    static BSTNode* rotateLeft(BSTNode* node) {
+        BSTNode* top = node -> right;
+        node -> right = top -> left;
+        top -> left = node;
+        updateHeight(node);
+        updateHeight(top);
+        return top;
+    }
+
+    // Lift the left child above node (returns the new subtree root)
+    static BSTNode* rotateRight(BSTNode* node) {
+        BSTNode* top = node -> left;
+        node -> left = top -> right;
+        top -> right = node;
+        updateHeight(node);
+        updateHeight(top);
+        return top;
+    }
+
+    // Restore the height rule at node after one side changed by one level
+    static BSTNode* rebalance(BSTNode* node) {
+        updateHeight(node);
+        int balance = height(node -> right) - height(node -> left);
+        if (balance > 1) {
+            if (height(node -> right -> left) > height(node -> right -> right)) node -> right = rotateRight(node -> right);
+            return rotateLeft(node);
+        }
+        if (balance < -1) {
+            if (height(node -> left -> right) > height(node -> left -> left)) node -> left = rotateLeft(node -> left);
+            return rotateRight(node);
+        }
+        return node;
+    }
+
+    // Put a node into the subtree below 'into' (returns the new subtree root)
+    static BSTNode* linkBelow(BSTNode* node, BSTNode* into) {
+        if (into == NULL) return node;
+        if (isBetter(node, into)) into -> right = linkBelow(node, into -> right);
+        else into -> left = linkBelow(node, into -> left);
+        return rebalance(into);
+    }
 
-        displayInOrder(node -> right, rank);
+    // Take the leftmost (worst) node out of a subtree (returns the new subtree root)
+    static BSTNode* unlinkLeftmost(BSTNode* from, BSTNode*& leftmost) {
+        if (from -> left == NULL) {
+            leftmost = from;
+            return from -> right;
+        }
+        from -> left = unlinkLeftmost(from -> left, leftmost);
+        return rebalance(from);
+    }
 
-        if (rank <= 10) {
-            string diffText;
-            if (node -> difficulty == 3)
-                diffText = "Easy (3x3)";
-            else if (node -> difficulty == 4)
-                diffText = "Med (4x4)";
-            else
-                diffText = "Hard (5x5)";
+    // Take a node out of the subtree below 'from' (returns the new subtree root)
+    // (every node has a unique place because sequence numbers break ties)
+    static BSTNode* unlinkBelow(BSTNode* node, BSTNode* from) {
+        if (from == node) {
+            if (node -> left == NULL) return node -> right;
+            if (node -> right == NULL) return node -> left;
 
-            cout << G " ║ " C << setw(4) << right << rank << G " ║ " C;
+            // Replace with the next better score (leftmost node of the right subtree)
+            BSTNode* successor;
+            BSTNode* right = unlinkLeftmost(node -> right, successor);
+            successor -> left = node -> left;
+            successor -> right = right;
+            return rebalance(successor);
+        }
+        if (isBetter(node, from)) from -> right = unlinkBelow(node, from -> right);
+        else from -> left = unlinkBelow(node, from -> left);
+        return rebalance(from);
+    }
 
-            string name = node -> name;
-            if (name.length() > 20) name = name.substr(0, 20);
-            cout << setw(20) << right << name << G " ║ " C;
+    // Put a node into the tree
+    void link(BSTNode* node) {
+        totalScores++;
+        root = linkBelow(node, root);
+    }
 
-            cout << setw(15) << right << diffText << G " ║ " C;
+    // Take a node out of the tree and give it back to the pool
+    void unlink(BSTNode* node) {
+        root = unlinkBelow(node, root);
+        pool.release(node);
+        totalScores--;
+    }
 
-            cout << setw(6) << right << node -> moves << G " ║ " C; 
+    // Add a score with a given insert order
+    bool insertScore(string name, int moves, int difficulty, string theme, int sequence) {
+        ScoreGroup& group = groups[groupKey(difficulty, theme)];
+        bool full = (int)group.worst.size() >= keepPerGroup;
+        if (full && !ranksAbove(moves, sequence, group.worst[0])) return false;
 
-            string theme = node -> theme;
-            if (theme.length() > 25) theme = theme.substr(0, 25);
-            cout << setw(25) << right << theme << G " ║\n";
+        BSTNode* node = pool.allocate();
+        node -> name = name;
+        node -> moves = moves;
+        node -> difficulty = difficulty;
+        node -> theme = theme;
+        node -> sequence = sequence;
+        node -> height = 1;
+        node -> right = NULL;
+        node -> left = NULL;
+        link(node);
 
-            rank++;
+        if (full) {
+            unlink(group.worst[0]);
+            group.worst[0] = node;
+            siftDown(group, 0);
+        } else {
+            group.worst.push_back(node);
+            siftUp(group, (int)group.worst.size() - 1);
         }
+        return true;
+    }
+
+    // Display one leaderboard row
+    void displayRow(BSTNode& node, int rank) {
+        string diffText;
+        if (node.difficulty == 3)
+            diffText = "Easy (3x3)";
+        else if (node.difficulty == 4)
+            diffText = "Med (4x4)";
+        else if (node.difficulty == 5)
+            diffText = "Hard (5x5)";
+        else
+            diffText = "Custom (" + to_string(node.difficulty) + "x" + to_string(node.difficulty) + ")";
+
+        cout << G " ║ " C << setw(4) << right << rank << G " ║ " C;
+
+        string name = node.name;
+        if (name.length() > 20) name = name.substr(0, 20);
+        cout << setw(20) << right << name << G " ║ " C;
 
-        displayInOrder(node -> left, rank);
+        cout << setw(15) << right << diffText << G " ║ " C;
+
+        cout << setw(6) << right << node.moves << G " ║ " C; 
+
+        string theme = node.theme;
+        if (theme.length() > 25) theme = theme.substr(0, 25);
+        cout << setw(25) << right << theme << G " ║\n";
     }
     
     // Recursively save scores to file
@@ -192,14 +404,6 @@ private:
              << node -> difficulty << "|" << node -> theme << "\n";
         saveToFileHelper(node -> left, file);
     }
-
-    // Recursively delete all nodes
-    void destroyTree(BSTNode* node) {
-        if (node == NULL) return;
-        destroyTree(node -> right);
-        destroyTree(node -> left);
-        delete node;
-    }
 };
 
 #endif
\ No newline at end of file
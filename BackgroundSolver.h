@@ -0,0 +1,198 @@
+// Background Solver: Solves boards on a worker thread while the game keeps running
+#ifndef BACKGROUNDSOLVER_H
+#define BACKGROUNDSOLVER_H
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Solver.h"
+#include "AnytimeSolver.h"
+using namespace std;
+
+#define ANYTIME_MIN_SIZE 5      // Grids this big get a quick answer that improves over time
+#define ANYTIME_SLICE_MS 8      // Search time between published answers
+#define SLOT_FRESH 4            // Set on the shared slot index while it holds a value not yet taken
+
+// Board waiting to be solved
+struct SolveJob {
+    unsigned int ticket;
+    BoardTarget target;
+    unsigned char board[MAX_CELLS];
+};
+
+// Solve result, handed to the UI through the mailbox
+// Large boards get several answers per request, each shorter than the last
+struct SolveAnswer {
+    unsigned int ticket;                    // Request it answers
+    int length;                             // Number of moves, or SOLVE_GAVE_UP
+    int lowerBound;                         // The optimal solution has at least this many moves
+    bool final;                             // No shorter answer will follow
+    unsigned char path[SOLVE_MAX_LENGTH];   // Move codes of the solution
+};
+
+// Hands the newest value from one thread to another without locks or allocation
+// Three preallocated slots: one being written, one being read and one in between
+// - The writer fills getWriteSlot() and publish()es it, replacing a value never taken
+// - The reader take()s the newest published value (NULL if nothing new arrived)
+template <typename T>
+class LatestSlot {
+    T slots[3];
+    atomic<int> middle;     // Slot in between (| SLOT_FRESH once published and not yet taken)
+    int back;               // Slot the writer fills
+    int front;              // Slot the reader took last
+
+public:
+    LatestSlot() : middle(1), back(0), front(2) {}
+
+    LatestSlot(const LatestSlot&) = delete;
+    LatestSlot& operator=(const LatestSlot&) = delete;
+
+    T& getWriteSlot() {
+        return slots[back];
+    }
+
+    void publish() {
+        back = middle.exchange(back | SLOT_FRESH) & 3;
+    }
+
+    bool hasFresh() const {
+        return (middle.load() & SLOT_FRESH) != 0;
+    }
+
+    // Only the writer sets SLOT_FRESH, so a fresh slot seen here is still fresh after the exchange
+    T* take() {
+        if (!hasFresh()) return NULL;
+        front = middle.exchange(front) & 3;
+        return &slots[front];
+    }
+};
+
+// One worker thread that always works on the newest request only
+// - submit() replaces any waiting request and cancels the running one
+// - Requests and results go through LatestSlots; poll() takes results without blocking
+// - Boards of ANYTIME_MIN_SIZE and up use the anytime solver: the first answer
+//   comes within a couple of milliseconds and every shorter one replaces it
+// The UI thread never waits for the worker (the mutex only guards the wakeup) and
+// neither thread allocates per request
+class BackgroundSolver {
+    thread worker;
+    LatestSlot<SolveJob> jobs;              // Newest request not yet started (UI writes, worker reads)
+    LatestSlot<SolveAnswer> mailbox;        // Newest result not yet taken (worker writes, UI reads)
+    atomic<unsigned int> currentTicket;     // Ticket of the newest request
+    atomic<bool> stopping;
+    mutex wakeLock;
+    condition_variable wake;
+    long long nodeBudget;
+    AnytimeSolver* anytime;                 // Created on the first large board (owned by the worker)
+
+    // IDA*: one optimal answer (or none if cancelled)
+    void solveOptimal(SolveJob* job) {
+        SolveAnswer& answer = mailbox.getWriteSlot();
+        answer.ticket = job -> ticket;
+        answer.length = solveBoard(job -> target, job -> board, nodeBudget, answer.path,
+                                   &currentTicket, job -> ticket);
+        answer.lowerBound = answer.length;
+        answer.final = true;
+
+        if (answer.length == SOLVE_CANCELLED) return;
+        mailbox.publish();
+    }
+
+    // Put the anytime solver's best solution in the mailbox
+    void publishAnytime(unsigned int ticket, bool finished) {
+        SolveAnswer& answer = mailbox.getWriteSlot();
+        answer.ticket = ticket;
+        answer.length = anytime -> getSolution(answer.path);
+        answer.lowerBound = anytime -> lowerBound();
+        answer.final = finished;
+        mailbox.publish();
+    }
+
+    // Anytime search: the tile-by-tile solution at once, then an answer after every slice
+    // that found a shorter one, until the solution is optimal, the node budget is spent
+    // or the request is replaced
+    void solveAnytime(SolveJob* job) {
+        if (anytime == NULL) anytime = new AnytimeSolver();
+        anytime -> start(job -> target, job -> board);
+        bool better = anytime -> construct();
+
+        while (currentTicket.load() == job -> ticket && !stopping.load()) {
+            bool finished = anytime -> isFinished() || anytime -> getExpanded() >= nodeBudget;
+            if (better || finished) {
+                publishAnytime(job -> ticket, finished);
+                if (finished) return;
+            }
+            better = anytime -> improve(ANYTIME_SLICE_MS, &currentTicket, job -> ticket);
+        }
+    }
+
+    void run() {
+        while (true) {
+            {
+                unique_lock<mutex> lock(wakeLock);
+                wake.wait(lock, [this] { return stopping.load() || jobs.hasFresh(); });
+            }
+            if (stopping.load()) return;
+
+            SolveJob* job = jobs.take();
+            if (job == NULL || job -> ticket != currentTicket.load()) continue;    // Cancelled before it started
+
+            if (job -> target.gridSize >= ANYTIME_MIN_SIZE && job -> target.cells <= SIMD_MAX_CELLS) {
+                solveAnytime(job);
+            } else {
+                solveOptimal(job);
+            }
+        }
+    }
+
+public:
+    BackgroundSolver(long long nodeBudget)
+        : currentTicket(0), stopping(false), nodeBudget(nodeBudget), anytime(NULL) {
+        worker = thread(&BackgroundSolver::run, this);
+    }
+
+    ~BackgroundSolver() {
+        stopping = true;
+        cancel();
+        {
+            lock_guard<mutex> lock(wakeLock);
+        }
+        wake.notify_one();
+        worker.join();
+        delete anytime;
+    }
+
+    // Solve a board in the background (any older request is cancelled)
+    void submit(const BoardTarget& target, const unsigned char* board) {
+        SolveJob& job = jobs.getWriteSlot();
+        job.ticket = currentTicket.fetch_add(1) + 1;
+        job.target = target;
+        memcpy(job.board, board, target.cells);
+        jobs.publish();
+
+        {
+            lock_guard<mutex> lock(wakeLock);
+        }
+        wake.notify_one();
+    }
+
+    // Drop the running and waiting requests without starting a new one
+    // (a waiting request is skipped by the worker once its ticket is stale)
+    void cancel() {
+        currentTicket.fetch_add(1);
+    }
+
+    // Take the newest answer to the newest request if one has arrived
+    // Returns false (without waiting) if there is none
+    bool poll(SolveAnswer& answer) {
+        SolveAnswer* result = mailbox.take();
+        if (result == NULL) return false;
+
+        bool current = result -> ticket == currentTicket.load();
+        if (current) answer = *result;
+        return current;
+    }
+};
+
+#endif
@@ -0,0 +1,692 @@
+// Benchmark: Measures the game's hot paths one at a time
+//
+// Build:  g++ -O2 -std=c++11 -pthread Benchmark.cpp -o emoshift-bench
+//         (Windows/MinGW only, like the game: GameFunctions.h needs conio.h and windows.h)
+// Run:    emoshift-bench [--json file] [--max-scores N] [--anytime-boards N]
+//
+// Reports ns/op, heap allocations/op and ops/sec for each benchmark and
+// optionally writes the same results as JSON so runs can be compared.
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <new>
+#include <vector>
+#include <algorithm>
+#include "Grid.h"
+#include "Stack.h"
+#include "BST.h"
+#include "Display.h"
+#include "GlyphAtlas.h"
+#include "Themes.h"
+#include "GameSession.h"
+#include "Snapshot.h"
+#include "GameFunctions.h"
+#include "BoardEval.h"
+#include "AnytimeSolver.h"
+#include "EventLog.h"
+
+using namespace std;
+
+#define MAX_RESULTS 512
+
+// Globals the game headers expect (normally defined in main.cpp)
+BST leaderboard;
+GlyphAtlas glyphAtlas[NUM_THEMES + 1];
+
+// Count every heap allocation made while a benchmark runs
+// Every form of new and delete goes through these two functions; they are never
+// inlined, so the compiler does not pair a free() with a new it can see
+unsigned long long allocationCount = 0;
+
+__attribute__((noinline)) void* countedAllocate(size_t size, bool throwing) {
+    allocationCount++;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == NULL && throwing) throw bad_alloc();
+    return p;
+}
+
+__attribute__((noinline)) void countedFree(void* p) {
+    free(p);
+}
+
+void* operator new(size_t size) {
+    return countedAllocate(size, true);
+}
+
+void* operator new[](size_t size) {
+    return countedAllocate(size, true);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size, false);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size, false);
+}
+
+void operator delete(void* p) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+    countedFree(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete(void* p, const nothrow_t&) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p, const nothrow_t&) noexcept {
+    countedFree(p);
+}
+
+// One benchmark result
+struct BenchResult {
+    string name;
+    double nsPerOp;
+    double allocsPerOp;
+    double opsPerSec;
+};
+
+BenchResult results[MAX_RESULTS];
+int resultCount = 0;
+
+// Output sink that throws everything away (for render benchmarks)
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) { return c; }
+    streamsize xsputn(const char*, streamsize n) { return n; }
+};
+
+// Record and print one result
+void addResult(string name, double seconds, unsigned long long allocs, long long ops) {
+    if (ops <= 0) return;
+    if (resultCount >= MAX_RESULTS) {
+        cout << "  (too many results, " << name << " not recorded)\n";
+        return;
+    }
+
+    BenchResult& r = results[resultCount++];
+    r.name = name;
+    r.nsPerOp = seconds * 1e9 / ops;
+    r.allocsPerOp = (double)allocs / ops;
+    r.opsPerSec = seconds > 0 ? ops / seconds : 0;
+
+    cout << "  " << left << setw(36) << name << right
+         << setw(12) << fixed << setprecision(1) << r.nsPerOp << " ns/op"
+         << setw(10) << setprecision(2) << r.allocsPerOp << " allocs/op"
+         << setw(14) << setprecision(0) << r.opsPerSec << " ops/s\n";
+}
+
+// Timer that also tracks allocations since it was started
+class BenchTimer {
+    chrono::steady_clock::time_point start;
+    unsigned long long allocsAtStart;
+
+public:
+    BenchTimer() {
+        allocsAtStart = allocationCount;
+        start = chrono::steady_clock::now();
+    }
+
+    // Stop and record a result for the given number of operations
+    void stop(string name, long long ops) {
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        addResult(name, seconds, allocationCount - allocsAtStart, ops);
+    }
+};
+
+// Name with the grid size attached, e.g. "makeMove/4x4"
+string sized(string name, int gridSize) {
+    return name + "/" + to_string(gridSize) + "x" + to_string(gridSize);
+}
+
+// Random move direction (may be blocked by the grid edge)
+char randomDirection() {
+    static const char keys[4] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT};
+    return keys[rand() % 4];
+}
+
+// GAME LOGIC BENCHMARKS
+
+// Operation counts shrink with the grid so every size takes about as long
+// (isSolved and initializeGrid are one pass over the cells)
+void benchGameLogic(int gridSize) {
+    GameSession game;
+    game.gridSize = gridSize;
+    startRound(game, true);
+
+    int cells = gridSize * gridSize;
+    const int ops = 200000;
+    int fullScans = max(200, 20000000 / cells);
+    char directions[1024];
+    for (int i = 0; i < 1024; i++) directions[i] = randomDirection();
+
+    {
+        BenchTimer timer;
+        for (int i = 0; i < ops; i++) {
+            makeMove(game, directions[i & 1023]);
+        }
+        timer.stop(sized("makeMove", gridSize), ops);
+    }
+
+    {
+        int undone = 0;
+        BenchTimer timer;
+        while (undoMove(game)) undone++;
+        timer.stop(sized("undoMove", gridSize), undone);
+    }
+
+    {
+        // Worst case: a solved grid compares every cell
+        // (called through a volatile pointer so the loop is not optimized away)
+        initializeGrid(game, false);
+        bool (*volatile check)(GameSession&) = isSolved;
+        bool solved = true;
+        BenchTimer timer;
+        for (int i = 0; i < fullScans; i++) {
+            solved = check(game) && solved;
+        }
+        timer.stop(sized("isSolved", gridSize), fullScans);
+        if (!solved) cout << "  (unexpected: grid not solved)\n";
+    }
+
+    int rounds = max(20, fullScans / 100);
+    {
+        BenchTimer timer;
+        for (int i = 0; i < rounds; i++) {
+            initializeGrid(game, true);
+        }
+        timer.stop(sized("initializeGrid", gridSize), rounds);
+    }
+
+    {
+        BenchTimer timer;
+        for (int i = 0; i < rounds; i++) {
+            shuffleGrid(game);
+        }
+        timer.stop(sized("shuffleGrid", gridSize), rounds);
+    }
+}
+
+// CONTAINER BENCHMARKS
+
+// Fill a grid the way buildPattern does (resize, then one tile per cell)
+void fillGrid(Grid& grid, int gridSize) {
+    grid.resize(gridSize);
+    for (int c = 0; c < gridSize * gridSize; c++) grid.setTile(c, c);
+}
+
+// Rebuild a grid again and again
+// (called through a volatile pointer so the loop is not optimized away)
+void benchGridRebuild(int gridSize) {
+    Grid grid;
+    void (*volatile fill)(Grid&, int) = fillGrid;
+    const int rounds = 100000;
+    BenchTimer timer;
+    for (int r = 0; r < rounds; r++) {
+        fill(grid, gridSize);
+    }
+    timer.stop(sized("grid rebuild", gridSize), rounds);
+}
+
+// Move history: one long game pushed and undone, and many short rounds cleared
+void benchStack() {
+    Stack history;
+    const int moves = 1000000;
+    {
+        BenchTimer timer;
+        for (int i = 0; i < moves; i++) history.push(KEY_UP, i + 1);
+        while (!history.isEmpty()) history.pop();
+        timer.stop("Stack 1M push + 1M pop", 1);
+    }
+    {
+        const int rounds = 1000;
+        BenchTimer timer;
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < 1000; i++) history.push(KEY_UP, i + 1);
+            history.clear();
+        }
+        timer.stop("Stack 1k push + clear", rounds);
+    }
+}
+
+// Snapshot encode/decode of a game in progress
+void benchSnapshot(int gridSize) {
+    GameSession game;
+    game.gridSize = gridSize;
+    startRound(game, true);
+    for (int i = 0; i < 40; i++) makeMove(game, randomDirection());
+
+    const int ops = 50000;
+    string data;
+    {
+        BenchTimer timer;
+        for (int i = 0; i < ops; i++) data = saveSnapshot(game);
+        timer.stop(sized("saveSnapshot", gridSize), ops);
+    }
+
+    GameSession restored;
+    {
+        BenchTimer timer;
+        for (int i = 0; i < ops; i++) loadSnapshot(restored, data);
+        timer.stop(sized("loadSnapshot", gridSize), ops);
+    }
+}
+
+// Full displayGrid frame written into a null sink
+void benchRender(int gridSize) {
+    GameSession game;
+    game.gridSize = gridSize;
+    startRound(game, true);
+
+    NullBuffer nullBuffer;
+    streambuf* original = cout.rdbuf(&nullBuffer);
+
+    int cells = gridSize * gridSize;
+    int frames = max(100, 2000000 / cells);
+    BenchTimer timer;
+    for (int i = 0; i < frames; i++) {
+        displayGrid(game);
+    }
+
+    cout.rdbuf(original);
+    timer.stop(sized("displayGrid", gridSize), frames);
+}
+
+// Batch evaluation of scrambled boards with every kernel the CPU supports
+// Each op is one board, so ops/s is boards/sec
+void benchBoardEval(int gridSize) {
+    GameSession game;
+    game.gridSize = gridSize;
+    startRound(game, true);
+
+    const int count = 4096;
+    int cells = gridSize * gridSize;
+    unsigned char* boards = new unsigned char[count * cells];
+    unsigned char targetTiles[MAX_CELLS];
+    packBoard(game.targetGrid, gridSize, targetTiles);
+
+    BoardTarget target;
+    setTarget(target, targetTiles, gridSize);
+
+    // Boards at increasing distances from the solution (a few stay solved)
+    initializeGrid(game, false);
+    for (int b = 0; b < count; b++) {
+        if (b % 64 == 0) initializeGrid(game, false);
+        makeMove(game, randomDirection());
+        packBoard(game.currentGrid, gridSize, boards + b * cells);
+    }
+
+    int* expectedMisplaced = new int[count];
+    int* expectedManhattan = new int[count];
+    unsigned char* expectedSolved = new unsigned char[count];
+    int* misplaced = new int[count];
+    int* manhattan = new int[count];
+    unsigned char* solved = new unsigned char[count];
+    for (int b = 0; b < count; b++) {
+        evaluateBoard(target, boards + b * cells, expectedMisplaced[b], expectedManhattan[b]);
+        expectedSolved[b] = expectedMisplaced[b] == 0;
+    }
+
+    // General scalar code, which the fixed-size scalar code replaces for 3x3 to 5x5
+    if (gridSize >= 3 && gridSize <= 5) {
+        BenchTimer timer;
+        for (int i = 0; i < 500; i++) {
+            for (int b = 0; b < count; b++) evaluateBoard(target, boards + b * cells, misplaced[b], manhattan[b]);
+        }
+        timer.stop(sized("evaluateBoards-general", gridSize), 500LL * count);
+    }
+
+    // Grids over SIMD_MAX_CELLS only have the scalar code
+    static const char* kernelNames[3] = {"scalar", "sse", "avx2"};
+    int passes = max(10, 500 * 25 / cells);
+    int lastKernel = cells <= SIMD_MAX_CELLS ? bestEvaluator() : EVAL_SCALAR;
+    for (int kernel = EVAL_SCALAR; kernel <= lastKernel; kernel++) {
+        // Every kernel must agree with the general evaluateBoard() before it is timed
+        evaluateBoardsWith(kernel, target, boards, count, misplaced, manhattan, solved);
+        for (int b = 0; b < count; b++) {
+            if (misplaced[b] != expectedMisplaced[b] || manhattan[b] != expectedManhattan[b] ||
+                solved[b] != expectedSolved[b]) {
+                cout << "  (mismatch: " << kernelNames[kernel] << " board " << b << ")\n";
+                break;
+            }
+        }
+
+        BenchTimer timer;
+        for (int i = 0; i < passes; i++) {
+            evaluateBoardsWith(kernel, target, boards, count, misplaced, manhattan, solved);
+        }
+        timer.stop(sized(string("evaluateBoards-") + kernelNames[kernel], gridSize), (long long)passes * count);
+    }
+
+    delete[] boards;
+    delete[] expectedMisplaced;
+    delete[] expectedManhattan;
+    delete[] expectedSolved;
+    delete[] misplaced;
+    delete[] manhattan;
+    delete[] solved;
+}
+
+// EVENT LOG BENCHMARKS
+
+// Cost of logging a move on the game thread (the writer thread does the I/O)
+// The queue is flushed between batches so no event is dropped
+void benchEventLog(int gridSize) {
+    string filename = "bench_events.tmp";
+    GameSession game;
+    game.gridSize = gridSize;
+    startRound(game, true);
+
+    const int batch = EVENT_QUEUE_SIZE / 2;
+    const int batches = 200;
+    double seconds = 0;
+    unsigned long long allocs = 0;
+    {
+        EventLog log(filename);
+        log.startRound(game);
+        for (int b = 0; b < batches; b++) {
+            // Only the empty position moves (the hash copy follows it), the grid is left alone
+            char directions[batch];
+            for (int i = 0; i < batch; i++) directions[i] = randomDirection();
+
+            unsigned long long allocsAtStart = allocationCount;
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for (int i = 0; i < batch; i++) {
+                int row = game.emptyRow, col = game.emptyCol;
+                if (directions[i] == KEY_UP && row < gridSize - 1) game.emptyRow++;
+                else if (directions[i] == KEY_DOWN && row > 0) game.emptyRow--;
+                else if (directions[i] == KEY_LEFT && col < gridSize - 1) game.emptyCol++;
+                else if (directions[i] == KEY_RIGHT && col > 0) game.emptyCol--;
+                log.record(game, EVENT_MOVE, directions[i]);
+            }
+            seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            allocs += allocationCount - allocsAtStart;
+            log.flush();
+        }
+        if (log.getDropped() > 0) cout << "  (" << log.getDropped() << " events dropped)\n";
+    }
+    addResult(sized("EventLog::record", gridSize), seconds, allocs, (long long)batch * batches);
+
+    for (int age = 0; age <= EVENT_LOG_KEEP; age++) remove(eventLogName(filename, age).c_str());
+}
+
+// SOLVER BENCHMARKS
+
+// IDA* on boards dealt by startRound: the size-specialized search against the general one
+// Both expand the same nodes in the same order, so ops are nodes and the results must agree
+void benchSolver(int gridSize, int boardCount, long long nodeBudget) {
+    int cells = gridSize * gridSize;
+    vector<BoardTarget> targets(boardCount);
+    vector<unsigned char> boards(boardCount * cells);
+    for (int b = 0; b < boardCount; b++) {
+        GameSession game;
+        game.gridSize = gridSize;
+        startRound(game, true);
+
+        unsigned char tiles[MAX_CELLS];
+        packBoard(game.targetGrid, gridSize, tiles);
+        setTarget(targets[b], tiles, gridSize);
+        packBoard(game.currentGrid, gridSize, &boards[b * cells]);
+    }
+
+    static const char* engineNames[2] = {"general", "fixed"};
+    vector<int> lengths[2];
+    for (int engine = 0; engine < 2; engine++) {
+        long long nodes = 0;
+        SolveSearch s;
+        BenchTimer timer;
+        for (int b = 0; b < boardCount; b++) {
+            s.target = &targets[b];
+            s.nodeBudget = nodeBudget;
+            s.weight = 1;
+            s.ticket = NULL;
+            s.expectedTicket = 0;
+            s.hasDeadline = false;
+            lengths[engine].push_back(runSearch(s, &boards[b * cells], NULL, engine == 1));
+            nodes += min(s.nodes, nodeBudget);
+        }
+        timer.stop(sized(string("IDA*-") + engineNames[engine], gridSize), nodes);
+    }
+
+    int solved = 0;
+    for (int b = 0; b < boardCount; b++) {
+        if (lengths[0][b] != lengths[1][b]) cout << "  (mismatch: board " << b << ")\n";
+        if (lengths[1][b] >= 0) solved++;
+    }
+    cout << "  (" << solved << "/" << boardCount << " boards solved within " << nodeBudget << " nodes)\n";
+}
+
+// Anytime solver on scrambled 5x5 boards (as dealt by startRound)
+// Times the first solution (construct(), as BackgroundSolver does, then the search
+// if that failed) and prints the mean solution length and lower bound
+// at fixed points in time; ops/s of "anytime-first" is first solutions per second
+void benchAnytime(int boardCount) {
+    const int checkpoints[] = {16, 64, 256, 1000};
+    const int checkpointCount = 4;
+    double lengthSum[checkpointCount] = {0};
+    double boundSum[checkpointCount] = {0};
+    int optimalCount[checkpointCount] = {0};
+    double firstMax = 0;
+    double firstTotal = 0;
+    unsigned long long firstAllocs = 0;
+    int solvedCount = 0;
+
+    AnytimeSolver solver;
+    unsigned char path[SOLVE_MAX_LENGTH];
+    for (int b = 0; b < boardCount; b++) {
+        GameSession game;
+        game.gridSize = 5;
+        startRound(game, true);
+
+        unsigned char tiles[MAX_CELLS], board[MAX_CELLS];
+        packBoard(game.targetGrid, 5, tiles);
+        packBoard(game.currentGrid, 5, board);
+        BoardTarget target;
+        setTarget(target, tiles, 5);
+
+        unsigned long long allocsAtStart = allocationCount;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        solver.start(target, board);
+        solver.construct();
+        while (!solver.hasSolution() && !solver.isFinished()) solver.improve(1);
+        double first = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (!solver.hasSolution()) continue;
+
+        solvedCount++;
+        firstTotal += first;
+        firstAllocs += allocationCount - allocsAtStart;
+        if (first > firstMax) firstMax = first;
+
+        for (int c = 0; c < checkpointCount; c++) {
+            int left = checkpoints[c] - (int)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+            if (left > 0 && !solver.isFinished()) solver.improve(left);
+            lengthSum[c] += solver.getSolution(path);
+            boundSum[c] += solver.lowerBound();
+            if (solver.lowerBound() >= solver.getSolution(path)) optimalCount[c]++;
+        }
+    }
+    if (solvedCount == 0) return;
+
+    addResult("anytime-first/5x5", firstTotal, firstAllocs, solvedCount);
+    cout << "  first solution: mean " << fixed << setprecision(1) << firstTotal * 1000 / solvedCount
+         << " ms, max " << firstMax * 1000 << " ms (" << solvedCount << "/" << boardCount << " boards)\n";
+    for (int c = 0; c < checkpointCount; c++) {
+        cout << "  after " << setw(4) << checkpoints[c] << " ms: mean length " << setprecision(1)
+             << lengthSum[c] / solvedCount << ", mean lower bound " << boundSum[c] / solvedCount
+             << ", proven optimal " << optimalCount[c] << "/" << solvedCount << "\n";
+    }
+}
+
+// LEADERBOARD BENCHMARKS
+
+// Write a leaderboard file with random scores
+void writeScoreFile(string filename, int count) {
+    ofstream file(filename.c_str());
+    for (int i = 0; i < count; i++) {
+        file << "Player" << i << "|" << (rand() % 500 + 1) << "|" << (3 + rand() % 3) << "|Fruits\n";
+    }
+}
+
+// Write a leaderboard file in rank order (as saveToFile writes it)
+void writeRankedScoreFile(string filename, int count) {
+    ofstream file(filename.c_str());
+    for (int i = 0; i < count; i++) {
+        int difficulty = 5 - (int)(3LL * i / count);
+        int moves = 10 + (int)((3LL * i % count) * 500 / count);     // Rising within each difficulty
+        file << "Player" << i << "|" << moves << "|" << difficulty << "|Fruits\n";
+    }
+}
+
+// Leaderboard screen on a file that is not loaded yet (should not depend on file size)
+void benchLeaderboardScreen(int count) {
+    string label = to_string(count);
+    string filename = "bench_ranked.tmp";
+    writeRankedScoreFile(filename, count);
+
+    NullBuffer nullBuffer;
+    streambuf* original = cout.rdbuf(&nullBuffer);
+    const int opens = 200;
+    {
+        BenchTimer timer;
+        for (int i = 0; i < opens; i++) {
+            BST tree;
+            tree.openLazy(filename);
+            tree.display();
+        }
+        cout.rdbuf(original);
+        timer.stop("BST::openLazy+display/" + label, opens);
+    }
+    cout.rdbuf(&nullBuffer);
+    {
+        BenchTimer timer;
+        for (int i = 0; i < opens; i++) {
+            BST tree;
+            tree.openLazy(filename);
+            vector<BSTNode> top;
+            tree.topScores(10, 5, top);
+        }
+        cout.rdbuf(original);
+        timer.stop("BST::topScores-5x5/" + label, opens);
+    }
+    remove(filename.c_str());
+}
+
+void benchLeaderboard(int count) {
+    string label = to_string(count);
+    string filename = "bench_scores.tmp";
+
+    {
+        BST tree;
+        BenchTimer timer;
+        for (int i = 0; i < count; i++) {
+            tree.insert("Player", rand() % 500 + 1, 3 + rand() % 3, "Fruits");
+        }
+        timer.stop("BST::insert/" + label, count);
+        cout << "  (kept " << tree.getSize() << " of " << count << " scores)\n";
+    }
+
+    writeScoreFile(filename, count);
+    BST tree;
+    {
+        BenchTimer timer;
+        tree.loadFromFile(filename);
+        timer.stop("BST::loadFromFile/" + label, count);
+    }
+
+    {
+        // Only the kept scores are written, so ops are rows written
+        int rows = tree.getSize();
+        BenchTimer timer;
+        tree.saveToFile(filename);
+        timer.stop("BST::saveToFile/" + label, rows);
+    }
+    remove(filename.c_str());
+}
+
+// Write all results as JSON
+void writeJson(string filename) {
+    ofstream file(filename.c_str());
+    file << "{\n  \"benchmarks\": [\n";
+    for (int i = 0; i < resultCount; i++) {
+        file << "    {\"name\": \"" << results[i].name << "\", "
+             << fixed << setprecision(2)
+             << "\"ns_per_op\": " << results[i].nsPerOp << ", "
+             << "\"allocs_per_op\": " << results[i].allocsPerOp << ", "
+             << "\"ops_per_sec\": " << setprecision(0) << results[i].opsPerSec << "}"
+             << (i + 1 < resultCount ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    string jsonFile = "";
+    int maxScores = 1000000;
+    int anytimeBoards = 8;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) jsonFile = argv[++i];
+        else if (arg == "--max-scores" && i + 1 < argc) maxScores = atoi(argv[++i]);
+        else if (arg == "--anytime-boards" && i + 1 < argc) anytimeBoards = atoi(argv[++i]);
+    }
+
+    srand(12345);
+    buildGlyphAtlases();
+
+    cout << "Game logic\n";
+    for (int size = MIN_GRID_SIZE; size <= MAX_GRID_SIZE; size++) benchGameLogic(size);
+
+    cout << "Containers\n";
+    for (int size = 3; size <= 5; size++) benchGridRebuild(size);
+    benchStack();
+
+    cout << "Snapshots\n";
+    for (int size = 3; size <= 5; size++) benchSnapshot(size);
+
+    cout << "Board evaluation (boards/sec)\n";
+    for (int size = MIN_GRID_SIZE; size <= MAX_GRID_SIZE; size++) benchBoardEval(size);
+
+    cout << "IDA* (nodes/sec)\n";
+    benchSolver(3, 200, 2000000);
+    benchSolver(4, 10, 2000000);
+    benchSolver(5, 5, 2000000);
+
+    cout << "Event log\n";
+    for (int size = 3; size <= 5; size++) benchEventLog(size);
+
+    cout << "Anytime solver (5x5, " << anytimeBoards << " boards)\n";
+    if (anytimeBoards > 0) benchAnytime(anytimeBoards);
+
+    cout << "Rendering (null sink)\n";
+    for (int size = MIN_GRID_SIZE; size <= MAX_GRID_SIZE; size++) benchRender(size);
+
+    cout << "Leaderboard\n";
+    int scoreCounts[] = {1000, 100000, 1000000};
+    for (int i = 0; i < 3; i++) {
+        if (scoreCounts[i] <= maxScores) benchLeaderboard(scoreCounts[i]);
+    }
+    for (int i = 0; i < 3; i++) {
+        if (scoreCounts[i] <= maxScores) benchLeaderboardScreen(scoreCounts[i]);
+    }
+
+    if (jsonFile != "") {
+        writeJson(jsonFile);
+        cout << "Results written to " << jsonFile << "\n";
+    }
+    return 0;
+}
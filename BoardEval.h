@@ -0,0 +1,293 @@
+// Board Evaluator: Scores many packed boards at once against one target pattern
+// For every board: misplaced tiles, Manhattan distance and whether it is solved
+#ifndef BOARDEVAL_H
+#define BOARDEVAL_H
+
+#include <cstring>
+#include "GameSession.h"
+using namespace std;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BOARDEVAL_X86
+#include <immintrin.h>
+#endif
+
+#define SIMD_MAX_CELLS 32       // SIMD kernels handle grids up to 5x5 (larger grids use scalar code)
+
+// A packed board is gridSize * gridSize bytes, one tile ID per cell, row by row
+// Boards in a batch are stored back to back
+
+// Target pattern with lookup tables prepared for the kernels
+struct BoardTarget {
+    int gridSize;
+    int cells;
+    unsigned char tiles[MAX_CELLS];         // Target tile of each cell
+    unsigned char goalRow[MAX_CELLS];       // Row where each tile ID belongs
+    unsigned char goalCol[MAX_CELLS];       // Column where each tile ID belongs
+    unsigned char cellRow[SIMD_MAX_CELLS];  // Row of each cell
+    unsigned char cellCol[SIMD_MAX_CELLS];  // Column of each cell
+};
+
+// Copy a grid's tiles into a packed board
+void packBoard(Grid& grid, int gridSize, unsigned char* out) {
+    memcpy(out, grid.cells(), gridSize * gridSize);
+}
+
+// Prepare a target pattern (packed board) for evaluation
+void setTarget(BoardTarget& target, const unsigned char* tiles, int gridSize) {
+    memset(&target, 0, sizeof(target));
+    target.gridSize = gridSize;
+    target.cells = gridSize * gridSize;
+
+    for (int c = 0; c < target.cells; c++) {
+        target.tiles[c] = tiles[c];
+        target.goalRow[tiles[c]] = c / gridSize;
+        target.goalCol[tiles[c]] = c % gridSize;
+        if (c < SIMD_MAX_CELLS) {
+            target.cellRow[c] = c / gridSize;
+            target.cellCol[c] = c % gridSize;
+        }
+    }
+}
+
+// Score one board (reference implementation)
+void evaluateBoard(const BoardTarget& target, const unsigned char* board,
+                   int& misplaced, int& manhattan) {
+    misplaced = 0;
+    manhattan = 0;
+    int c = 0;
+    for (int i = 0; i < target.gridSize; i++) {
+        for (int j = 0; j < target.gridSize; j++, c++) {
+            int tile = board[c];
+            if (tile == 0) continue;    // The empty space does not count
+
+            if (tile != target.tiles[c]) misplaced++;
+            int dRow = i - target.goalRow[tile];
+            int dCol = j - target.goalCol[tile];
+            manhattan += (dRow < 0 ? -dRow : dRow) + (dCol < 0 ? -dCol : dCol);
+        }
+    }
+}
+
+// evaluateBoard() for an N x N grid (constant-size loop the compiler unrolls)
+template <int N>
+inline void evaluateBoardFixed(const BoardTarget& target, const unsigned char* board,
+                               int& misplaced, int& manhattan) {
+    misplaced = 0;
+    manhattan = 0;
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            int c = i * N + j;
+            int tile = board[c];
+            int counted = tile != 0;        // Without branches: the empty space counts as 0
+            misplaced += counted & (tile != target.tiles[c]);
+            int dRow = i - target.goalRow[tile];
+            int dCol = j - target.goalCol[tile];
+            manhattan += counted * ((dRow < 0 ? -dRow : dRow) + (dCol < 0 ? -dCol : dCol));
+        }
+    }
+}
+
+// Score boards first..end-1 of an N x N batch
+template <int N>
+void evaluateRangeFixed(const BoardTarget& target, const unsigned char* boards, int first, int end,
+                        int* misplaced, int* manhattan, unsigned char* solved) {
+    for (int b = first; b < end; b++) {
+        evaluateBoardFixed<N>(target, boards + b * N * N, misplaced[b], manhattan[b]);
+        solved[b] = misplaced[b] == 0;
+    }
+}
+
+// Score boards first..end-1 one at a time (end is an index, not a number of boards)
+// 3x3, 4x4 and 5x5 use the fixed-size loop, other sizes the general one
+void evaluateBoardsScalar(const BoardTarget& target, const unsigned char* boards, int first, int end,
+                          int* misplaced, int* manhattan, unsigned char* solved) {
+    switch (target.gridSize) {
+        case 3: evaluateRangeFixed<3>(target, boards, first, end, misplaced, manhattan, solved); return;
+        case 4: evaluateRangeFixed<4>(target, boards, first, end, misplaced, manhattan, solved); return;
+        case 5: evaluateRangeFixed<5>(target, boards, first, end, misplaced, manhattan, solved); return;
+    }
+    for (int b = first; b < end; b++) {
+        evaluateBoard(target, boards + b * target.cells, misplaced[b], manhattan[b]);
+        solved[b] = misplaced[b] == 0;
+    }
+}
+
+#ifdef BOARDEVAL_X86
+
+// Score 16 cells: returns misplaced count, adds Manhattan distance to sum
+// rows/cols: goal row/column tables for tiles 0-15 and 16-31
+__attribute__((target("ssse3")))
+inline int evaluateHalfSSE(__m128i tiles, __m128i targetTiles, __m128i valid,
+                           __m128i rowsLo, __m128i rowsHi, __m128i colsLo, __m128i colsHi,
+                           __m128i cellRow, __m128i cellCol, __m128i& sum) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i counted = _mm_andnot_si128(_mm_cmpeq_epi8(tiles, zero), valid);  // Non-empty cells of this board
+
+    // Misplaced: counted cells that differ from the target
+    __m128i wrong = _mm_andnot_si128(_mm_cmpeq_epi8(tiles, targetTiles), counted);
+    int misplaced = __builtin_popcount(_mm_movemask_epi8(wrong));
+
+    // Goal row/column of each tile through two 16-entry table lookups
+    // (pshufb returns 0 for indexes with the top bit set)
+    __m128i lowIndex = _mm_or_si128(tiles, _mm_cmpgt_epi8(tiles, _mm_set1_epi8(15)));
+    __m128i highIndex = _mm_sub_epi8(tiles, _mm_set1_epi8(16));
+    __m128i goalRow = _mm_or_si128(_mm_shuffle_epi8(rowsLo, lowIndex), _mm_shuffle_epi8(rowsHi, highIndex));
+    __m128i goalCol = _mm_or_si128(_mm_shuffle_epi8(colsLo, lowIndex), _mm_shuffle_epi8(colsHi, highIndex));
+
+    // |a - b| on unsigned bytes is max(a, b) - min(a, b)
+    __m128i dRow = _mm_sub_epi8(_mm_max_epu8(goalRow, cellRow), _mm_min_epu8(goalRow, cellRow));
+    __m128i dCol = _mm_sub_epi8(_mm_max_epu8(goalCol, cellCol), _mm_min_epu8(goalCol, cellCol));
+    __m128i distance = _mm_and_si128(_mm_add_epi8(dRow, dCol), counted);
+    sum = _mm_add_epi64(sum, _mm_sad_epu8(distance, zero));
+
+    return misplaced;
+}
+
+// SSE kernel: one board per iteration (two 16-byte halves)
+__attribute__((target("ssse3")))
+void evaluateBoardsSSE(const BoardTarget& target, const unsigned char* boards, int count,
+                       int* misplaced, int* manhattan, unsigned char* solved) {
+    int cells = target.cells;
+    unsigned char targetBytes[SIMD_MAX_CELLS] = {0};
+    unsigned char validBytes[SIMD_MAX_CELLS] = {0};
+    for (int c = 0; c < cells; c++) {
+        targetBytes[c] = target.tiles[c];
+        validBytes[c] = 0xFF;
+    }
+
+    __m128i target0 = _mm_loadu_si128((const __m128i*)targetBytes);
+    __m128i target1 = _mm_loadu_si128((const __m128i*)(targetBytes + 16));
+    __m128i valid0 = _mm_loadu_si128((const __m128i*)validBytes);
+    __m128i valid1 = _mm_loadu_si128((const __m128i*)(validBytes + 16));
+    __m128i rowsLo = _mm_loadu_si128((const __m128i*)target.goalRow);
+    __m128i rowsHi = _mm_loadu_si128((const __m128i*)(target.goalRow + 16));
+    __m128i colsLo = _mm_loadu_si128((const __m128i*)target.goalCol);
+    __m128i colsHi = _mm_loadu_si128((const __m128i*)(target.goalCol + 16));
+    __m128i cellRow0 = _mm_loadu_si128((const __m128i*)target.cellRow);
+    __m128i cellRow1 = _mm_loadu_si128((const __m128i*)(target.cellRow + 16));
+    __m128i cellCol0 = _mm_loadu_si128((const __m128i*)target.cellCol);
+    __m128i cellCol1 = _mm_loadu_si128((const __m128i*)(target.cellCol + 16));
+
+    // Each load reads 16 or 32 bytes, so the last boards are done in scalar code
+    int loadBytes = cells > 16 ? 32 : 16;
+    int safeCount = count - (loadBytes + cells - 1) / cells;
+    if (safeCount < 0) safeCount = 0;
+
+    for (int b = 0; b < safeCount; b++) {
+        const unsigned char* board = boards + b * cells;
+        __m128i sum = _mm_setzero_si128();
+
+        int wrong = evaluateHalfSSE(_mm_loadu_si128((const __m128i*)board), target0, valid0,
+                                    rowsLo, rowsHi, colsLo, colsHi, cellRow0, cellCol0, sum);
+        if (cells > 16) {
+            wrong += evaluateHalfSSE(_mm_loadu_si128((const __m128i*)(board + 16)), target1, valid1,
+                                     rowsLo, rowsHi, colsLo, colsHi, cellRow1, cellCol1, sum);
+        }
+
+        misplaced[b] = wrong;
+        manhattan[b] = _mm_cvtsi128_si32(sum) + _mm_extract_epi16(sum, 4);
+        solved[b] = wrong == 0;
+    }
+
+    evaluateBoardsScalar(target, boards, safeCount, count, misplaced, manhattan, solved);   // Tail: boards safeCount..count-1
+}
+
+// AVX2 kernel: one board per iteration in a single 32-byte register
+__attribute__((target("avx2")))
+void evaluateBoardsAVX2(const BoardTarget& target, const unsigned char* boards, int count,
+                        int* misplaced, int* manhattan, unsigned char* solved) {
+    int cells = target.cells;
+    unsigned char targetBytes[SIMD_MAX_CELLS] = {0};
+    unsigned char validBytes[SIMD_MAX_CELLS] = {0};
+    for (int c = 0; c < cells; c++) {
+        targetBytes[c] = target.tiles[c];
+        validBytes[c] = 0xFF;
+    }
+
+    __m256i zero = _mm256_setzero_si256();
+    __m256i targetTiles = _mm256_loadu_si256((const __m256i*)targetBytes);
+    __m256i valid = _mm256_loadu_si256((const __m256i*)validBytes);
+    __m256i cellRow = _mm256_loadu_si256((const __m256i*)target.cellRow);
+    __m256i cellCol = _mm256_loadu_si256((const __m256i*)target.cellCol);
+
+    // vpshufb looks up within each 128-bit lane, so both lanes get the same table
+    __m256i rowsLo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)target.goalRow));
+    __m256i rowsHi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(target.goalRow + 16)));
+    __m256i colsLo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)target.goalCol));
+    __m256i colsHi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(target.goalCol + 16)));
+    __m256i fifteen = _mm256_set1_epi8(15);
+    __m256i sixteen = _mm256_set1_epi8(16);
+
+    int safeCount = count - (32 + cells - 1) / cells;
+    if (safeCount < 0) safeCount = 0;
+
+    for (int b = 0; b < safeCount; b++) {
+        __m256i tiles = _mm256_loadu_si256((const __m256i*)(boards + b * cells));
+        __m256i counted = _mm256_andnot_si256(_mm256_cmpeq_epi8(tiles, zero), valid);
+
+        __m256i wrongCells = _mm256_andnot_si256(_mm256_cmpeq_epi8(tiles, targetTiles), counted);
+        int wrong = __builtin_popcount((unsigned int)_mm256_movemask_epi8(wrongCells));
+
+        __m256i lowIndex = _mm256_or_si256(tiles, _mm256_cmpgt_epi8(tiles, fifteen));
+        __m256i highIndex = _mm256_sub_epi8(tiles, sixteen);
+        __m256i goalRow = _mm256_or_si256(_mm256_shuffle_epi8(rowsLo, lowIndex), _mm256_shuffle_epi8(rowsHi, highIndex));
+        __m256i goalCol = _mm256_or_si256(_mm256_shuffle_epi8(colsLo, lowIndex), _mm256_shuffle_epi8(colsHi, highIndex));
+
+        __m256i dRow = _mm256_sub_epi8(_mm256_max_epu8(goalRow, cellRow), _mm256_min_epu8(goalRow, cellRow));
+        __m256i dCol = _mm256_sub_epi8(_mm256_max_epu8(goalCol, cellCol), _mm256_min_epu8(goalCol, cellCol));
+        __m256i distance = _mm256_and_si256(_mm256_add_epi8(dRow, dCol), counted);
+        __m256i sum = _mm256_sad_epu8(distance, zero);      // Four 64-bit partial sums
+
+        __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        misplaced[b] = wrong;
+        manhattan[b] = _mm_cvtsi128_si32(half) + _mm_extract_epi16(half, 4);
+        solved[b] = wrong == 0;
+    }
+
+    evaluateBoardsScalar(target, boards, safeCount, count, misplaced, manhattan, solved);   // Tail: boards safeCount..count-1
+}
+
+#endif
+
+// Kernels available for evaluateBoards()
+#define EVAL_SCALAR 0
+#define EVAL_SSE 1
+#define EVAL_AVX2 2
+
+// Best kernel this CPU supports (checked once)
+int bestEvaluator() {
+#ifdef BOARDEVAL_X86
+    static int best = __builtin_cpu_supports("avx2") ? EVAL_AVX2 :
+                      __builtin_cpu_supports("ssse3") ? EVAL_SSE : EVAL_SCALAR;
+    return best;
+#else
+    return EVAL_SCALAR;
+#endif
+}
+
+// Score count boards with a given kernel (falls back to scalar if unsupported)
+void evaluateBoardsWith(int kernel, const BoardTarget& target, const unsigned char* boards, int count,
+                        int* misplaced, int* manhattan, unsigned char* solved) {
+#ifdef BOARDEVAL_X86
+    if (target.cells <= SIMD_MAX_CELLS && kernel <= bestEvaluator()) {
+        if (kernel == EVAL_AVX2) {
+            evaluateBoardsAVX2(target, boards, count, misplaced, manhattan, solved);
+            return;
+        }
+        if (kernel == EVAL_SSE) {
+            evaluateBoardsSSE(target, boards, count, misplaced, manhattan, solved);
+            return;
+        }
+    }
+#endif
+    evaluateBoardsScalar(target, boards, 0, count, misplaced, manhattan, solved);
+}
+
+// Score count boards with the fastest kernel for this CPU
+void evaluateBoards(const BoardTarget& target, const unsigned char* boards, int count,
+                    int* misplaced, int* manhattan, unsigned char* solved) {
+    evaluateBoardsWith(bestEvaluator(), target, boards, count, misplaced, manhattan, solved);
+}
+
+#endif
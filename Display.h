@@ -31,15 +31,21 @@ void logo() {
     cout << "                ╚══════╝╚═╝  ╚═╝╚═╝╚═╝        ╚═╝         \n" C;
 }
 
-// Center grid output based on grid size
-void centerGrid(int gridSize) {
-    if (gridSize == 3) {
-        cout << "\n\t\t\t  ";
-    } else if (gridSize == 4) {
-        cout << "\n\t\t       ";
-    } else if (gridSize == 5) {
-        cout << "\n\t\t   ";
-    }
+// Center grid output based on the width of one grid row (in columns)
+void centerGrid(string& frame, int rowWidth) {
+    int indent = (74 - rowWidth) / 2;
+    if (indent < 0) indent = 0;
+    frame += "\n" + string(indent, ' ');
+}
+
+// Label for grid sizes outside the three standard difficulties
+string customSizeLabel(int gridSize) {
+    return "𝐂 𝐔 𝐒 𝐓 𝐎 𝐌 (" + to_string(gridSize) + "x" + to_string(gridSize) + ")";
+}
+
+// Column width of customSizeLabel() (bold letters are one column each)
+int customSizeLabelWidth(int gridSize) {
+    return 15 + 2 * to_string(gridSize).length();
 }
 
 void displayDifficultyHeader(int gridSize) {
@@ -55,6 +61,14 @@ void displayDifficultyHeader(int gridSize) {
         cout << "╚════════════════════════════════════════════════════════════════════════╝ \n"; 
         cout << M;
     } 
+    else if (gridSize != 5) {
+        int space = 52 - customSizeLabelWidth(gridSize);
+        cout << "╔════════════════════════════════════════════════════════════════════════╗ \n";
+        cout << "║ " << (gridSize < 3 ? E : H) << "[Q] ← " << string(space / 2, ' ') << customSizeLabel(gridSize)
+             << string(space - space / 2, ' ') << "[U] ↶  [R] ↻ " C "║ \n";
+        cout << "╚════════════════════════════════════════════════════════════════════════╝ \n"; 
+        cout << (gridSize < 3 ? E : H);
+    }
     else {
         cout << "╔════════════════════════════════════════════════════════════════════════╗ \n";
         cout << "║ " H "[Q] ← \t                 𝐇 𝐀 𝐑 𝐃\t            [U] ↶  [R] ↻ " C "║ \n";
@@ -64,7 +78,7 @@ void displayDifficultyHeader(int gridSize) {
 }
 
 void setDifficultyColor(int gridSize) {
-    if (gridSize == 3) {
+    if (gridSize <= 3) {
         cout << E;
     } else if (gridSize == 4) {
         cout << M;
@@ -108,6 +122,22 @@ void displayCongratulations() {
     cout << "\t\t    𝐘 𝐎 𝐔   𝐒 𝐎 𝐋 𝐕 𝐄 𝐃   𝐈 𝐓! \n\n";
 }
 
+void displayRaceResult(bool playerWon) {
+    cout << "\n\n";
+    if (playerWon) {
+        cout << C "          🏁🏁🏁  ＹＯＵ  ＷＯＮ  ＴＨＥ  ＲＡＣＥ  🏁🏁🏁  \n\n";
+    } else {
+        cout << C "          🤖🤖🤖  ＴＨＥ  ＣＯＭＰＵＴＥＲ  ＷＯＮ  🤖🤖🤖  \n\n";
+    }
+}
+
+void displayRaceSetup() {
+    logo();
+    cout << "\n\n";
+    cout << "                         RACE THE COMPUTER      \n";
+    cout << "           Both of you get the same puzzle. First to solve it wins!\n\n";
+}
+
 void displayWinHeader() {
     cout << G "\n\t\t     ▣ _ ▣  " Y "\033[1mＥＭＯ" G "ＳＨＩＦＴ\033[0m" Y "  ▣ _ ▣ \n\n";
     cout << C "\t\t      FINAL PATTERN (PERFECT MATCH) ";
@@ -130,6 +160,9 @@ void displayDifficultyInStats(int gridSize) {
         cout << E << left << setw(47) << "𝐄 𝐀 𝐒 𝐘 (3x3)";
     } else if (gridSize == 4) {
         cout << M << left << setw(57) << "𝐌 𝐄 𝐃 𝐈 𝐔 𝐌 (4x4)";
+    } else if (gridSize != 5) {
+        cout << (gridSize < 3 ? E : H) << customSizeLabel(gridSize)
+             << string(39 - customSizeLabelWidth(gridSize), ' ');
     } else {
         cout << H << left << setw(51) << "𝐇 𝐀 𝐑 𝐃 (5x5)";
     }
@@ -163,7 +196,10 @@ void displayMainMenu() {
     cout << "                        SELECT DIFFICULTY      \n\n";
     cout << E "                       [1] Easy (3x3 Grid)    \n";
     cout << M "                       [2] Medium (4x4 Grid)  \n";
-    cout << H "                       [3] Hard (5x5 Grid)    \n\n\n";
+    cout << H "                       [3] Hard (5x5 Grid)    \n";
+    cout << C "                       [5] Custom (2x2 - 16x16)\n";
+    cout << C "                       [6] Resume Last Game   \n";
+    cout << C "                       [7] Race the Computer  \n\n\n";
     cout << C "            [4] View Leaderboard          [0] Exit Game       \n\n";
 }
 
@@ -0,0 +1,270 @@
+// Event Log: Binary record of every game event, written to disk on its own thread
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include "GameSession.h"
+#include "Snapshot.h"
+#include "SpscQueue.h"
+using namespace std;
+
+#define EVENT_LOG_FILE "events.log"
+#define EVENT_LOG_VERSION 1
+#define EVENT_LOG_HEADER 8              // Bytes before the first record
+#define EVENT_RECORD_SIZE 24
+#define EVENT_LOG_MAX_BYTES (4 << 20)   // Start a new file after 4 MB
+#define EVENT_LOG_KEEP 3                // Old files kept (events.log.1 is the newest)
+#define EVENT_QUEUE_SIZE 4096           // Events waiting for the writer (power of two)
+#define EVENT_FLUSH_MS 100              // Writer wakes up at least this often
+
+// File layout (little endian):
+//   header   "EMLG", version, record size, 2 zero bytes
+//   records  of EVENT_RECORD_SIZE bytes each:
+//     [0..7]   time (microseconds since 1970)
+//     [8..15]  board hash after the event
+//     [16..19] session ID (one per playGame call)
+//     [20]     event type
+//     [21]     grid size
+//     [22]     move code of a move (see directionCode), otherwise 0
+//     [23]     0
+// One 4 MB file holds about 175,000 events
+enum EventType {
+    EVENT_START,            // Round started (new puzzle, retry or resumed game)
+    EVENT_MOVE,
+    EVENT_UNDO,
+    EVENT_RETRY,            // [R] during a round
+    EVENT_QUIT,             // [Q] during a round
+    EVENT_WIN,
+    NUM_EVENT_TYPES
+};
+
+const char* eventNames[NUM_EVENT_TYPES] = {"start", "move", "undo", "retry", "quit", "win"};
+
+// One logged event
+struct GameEvent {
+    unsigned long long time;
+    unsigned long long boardHash;
+    unsigned int session;
+    unsigned char type;
+    unsigned char gridSize;
+    unsigned char move;
+};
+
+// Append one event in file layout
+void encodeEvent(string& out, const GameEvent& event) {
+    putBytes(out, (unsigned int)event.time, 4);
+    putBytes(out, (unsigned int)(event.time >> 32), 4);
+    putBytes(out, (unsigned int)event.boardHash, 4);
+    putBytes(out, (unsigned int)(event.boardHash >> 32), 4);
+    putBytes(out, event.session, 4);
+    putBytes(out, event.type, 1);
+    putBytes(out, event.gridSize, 1);
+    putBytes(out, event.move, 1);
+    putBytes(out, 0, 1);
+}
+
+// Read one event in file layout (record points at EVENT_RECORD_SIZE bytes)
+void decodeEvent(const unsigned char* record, GameEvent& event) {
+    unsigned long long words[2];
+    for (int w = 0; w < 2; w++) {
+        words[w] = 0;
+        for (int i = 7; i >= 0; i--) words[w] = (words[w] << 8) | record[8 * w + i];
+    }
+    event.time = words[0];
+    event.boardHash = words[1];
+    event.session = record[16] | (record[17] << 8) | (record[18] << 16) | ((unsigned int)record[19] << 24);
+    event.type = record[20];
+    event.gridSize = record[21];
+    event.move = record[22];
+}
+
+// Check a file header (data points at EVENT_LOG_HEADER bytes)
+bool isEventLogHeader(const unsigned char* data) {
+    return data[0] == 'E' && data[1] == 'M' && data[2] == 'L' && data[3] == 'G' &&
+           data[4] == EVENT_LOG_VERSION && data[5] == EVENT_RECORD_SIZE;
+}
+
+// Name of a log file by age (0 = current file)
+string eventLogName(string filename, int age) {
+    return age == 0 ? filename : filename + "." + to_string(age);
+}
+
+// Shift filename -> filename.1 -> ... -> filename.keep (the oldest is dropped)
+// so the next write starts an empty file
+void rotateLogFiles(string filename, int keep) {
+    remove(eventLogName(filename, keep).c_str());
+    for (int age = keep - 1; age >= 0; age--) {
+        rename(eventLogName(filename, age).c_str(), eventLogName(filename, age + 1).c_str());
+    }
+}
+
+// Hash of the current board, updated in O(1) per move
+// Zobrist style: XOR of one key per (cell, tile) pair, keys made by a mixing function
+struct BoardHash {
+    unsigned long long value;
+    unsigned char tiles[MAX_CELLS];     // Copy of the board (finds the tile that moved)
+    int blank;
+};
+
+unsigned long long cellKey(int cell, int tile) {
+    unsigned long long x = ((unsigned long long)cell << 8 | tile) + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Hash the whole board (once per round)
+void resetBoardHash(BoardHash& hash, GameSession& game) {
+    hash.value = 0;
+    for (int i = 0; i < game.gridSize; i++) {
+        for (int j = 0; j < game.gridSize; j++) {
+            int cell = i * game.gridSize + j;
+            hash.tiles[cell] = (unsigned char)game.currentGrid.getTile(i, j);
+            hash.value ^= cellKey(cell, hash.tiles[cell]);
+        }
+    }
+    hash.blank = game.emptyRow * game.gridSize + game.emptyCol;
+}
+
+// Follow the empty space after a move or undo (the tile it passed moves the other way)
+void updateBoardHash(BoardHash& hash, GameSession& game) {
+    int blank = game.emptyRow * game.gridSize + game.emptyCol;
+    int tile = hash.tiles[blank];
+    hash.value ^= cellKey(blank, tile) ^ cellKey(hash.blank, 0) ^ cellKey(hash.blank, tile) ^ cellKey(blank, 0);
+    hash.tiles[hash.blank] = tile;
+    hash.tiles[blank] = 0;
+    hash.blank = blank;
+}
+
+// Event log of one playGame call
+// - record() stamps the event and pushes it into a lock-free queue (no I/O, no locks)
+// - The writer thread drains the queue in batches, appends them to the log file
+//   and starts a new file when it gets too big
+// If the writer falls behind and the queue is full, events are dropped and counted
+class EventLog {
+    thread writer;
+    SpscQueue<GameEvent, EVENT_QUEUE_SIZE> events;
+    atomic<bool> stopping;
+    atomic<unsigned int> dropped;
+    atomic<bool> flushing;
+    mutex wakeLock;
+    condition_variable wake;
+
+    string filename;
+    ofstream file;                  // Only used by the writer thread
+    long long fileSize;
+    unsigned int session;
+    BoardHash hash;                 // Only used by the game thread
+
+    // Open the current file for appending (a new file gets a header)
+    void openFile() {
+        file.open(filename.c_str(), ios::binary | ios::app);
+        file.seekp(0, ios::end);
+        fileSize = file.tellp();
+        if (fileSize <= 0) {
+            const char header[EVENT_LOG_HEADER] = {'E', 'M', 'L', 'G', EVENT_LOG_VERSION, EVENT_RECORD_SIZE, 0, 0};
+            file.write(header, EVENT_LOG_HEADER);
+            fileSize = EVENT_LOG_HEADER;
+        }
+    }
+
+    // Shift events.log -> events.log.1 -> ... and start an empty file
+    void rotate() {
+        file.close();
+        rotateLogFiles(filename, EVENT_LOG_KEEP);
+        openFile();
+    }
+
+    // Write everything in the queue (one write per file)
+    void drain(string& batch) {
+        GameEvent event;
+        while (!events.isEmpty()) {
+            batch.clear();
+            while (fileSize + (long long)batch.length() < EVENT_LOG_MAX_BYTES && events.pop(event)) {
+                encodeEvent(batch, event);
+            }
+            file.write(batch.data(), batch.length());
+            fileSize += batch.length();
+            if (fileSize >= EVENT_LOG_MAX_BYTES) rotate();
+        }
+        file.flush();
+    }
+
+    void run() {
+        string batch;
+        batch.reserve(EVENT_QUEUE_SIZE * EVENT_RECORD_SIZE);
+        while (!stopping.load()) {
+            {
+                unique_lock<mutex> lock(wakeLock);
+                wake.wait_for(lock, chrono::milliseconds(EVENT_FLUSH_MS), [this] { return stopping.load() || flushing.load(); });
+            }
+            drain(batch);
+        }
+        drain(batch);               // Events logged just before the end
+    }
+
+public:
+    EventLog(string filename = EVENT_LOG_FILE) : stopping(false), dropped(0), flushing(false), filename(filename) {
+        // Session IDs only need to differ between sittings
+        unsigned long long now = chrono::steady_clock::now().time_since_epoch().count();
+        session = (unsigned int)(cellKey((int)(now >> 20), (int)(now & 0xFF)) >> 32) ^ (unsigned int)rand();
+        hash.value = 0;
+        hash.blank = 0;
+        openFile();
+        writer = thread(&EventLog::run, this);
+    }
+
+    ~EventLog() {
+        {
+            lock_guard<mutex> lock(wakeLock);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+    }
+
+    // A round starts on the current board (hashes the whole board)
+    void startRound(GameSession& game) {
+        resetBoardHash(hash, game);
+        record(game, EVENT_START);
+    }
+
+    // Log an event on the current board (call after the move / undo is made)
+    // direction: arrow key of a move
+    void record(GameSession& game, EventType type, char direction = 0) {
+        if (type == EVENT_MOVE || type == EVENT_UNDO) updateBoardHash(hash, game);
+
+        GameEvent event;
+        event.time = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+        event.boardHash = hash.value;
+        event.session = session;
+        event.type = type;
+        event.gridSize = game.gridSize;
+        event.move = direction != 0 ? directionCode(direction) : 0;
+        if (!events.push(event)) dropped.fetch_add(1, memory_order_relaxed);
+    }
+
+    // Wait until the writer has taken every logged event
+    void flush() {
+        {
+            lock_guard<mutex> lock(wakeLock);
+            flushing = true;
+        }
+        wake.notify_one();
+        while (!events.isEmpty()) this_thread::yield();
+        flushing = false;
+    }
+
+    unsigned int getDropped() {
+        return dropped.load();
+    }
+};
+
+#endif
@@ -0,0 +1,167 @@
+// Event Stats: Summarizes the binary event logs written by playGame (see EventLog.h)
+//
+// Build:  g++ -O2 -std=c++11 -pthread EventStats.cpp -o emoshift-events
+// Run:    emoshift-events [--idle-ms M] [file ...]
+//
+// Without files it reads events.log.3 .. events.log.1 and events.log (oldest first).
+// Prints event counts, rounds, wins and per grid size the time between moves
+// (gaps of --idle-ms or more count as idle, not as move time) and the time
+// from the start of a round to the win.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+#include "EventLog.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+#define READ_RECORDS 65536      // Records per read (1.5 MB)
+
+// Where a session is in its current round
+struct SessionState {
+    unsigned long long roundStart;      // Time of the round's start event (0 if none seen)
+    unsigned long long lastMove;        // Time of the last start / move / undo
+};
+
+// Totals for one grid size
+struct SizeStats {
+    unsigned long long counts[NUM_EVENT_TYPES];
+    unsigned long long idleGaps;
+    LatencyHistogram moveTime;          // Microseconds between moves
+    LatencyHistogram solveTime;         // Milliseconds from round start to win
+
+    SizeStats() : idleGaps(0) {
+        for (int t = 0; t < NUM_EVENT_TYPES; t++) counts[t] = 0;
+    }
+};
+
+unordered_map<unsigned int, SessionState> sessions;
+SizeStats sizes[MAX_GRID_SIZE + 1];
+unsigned long long totalEvents = 0;
+unsigned long long badEvents = 0;
+unsigned long long idleLimit = 10000000;    // Microseconds
+
+void addEvent(const GameEvent& event) {
+    totalEvents++;
+    if (event.type >= NUM_EVENT_TYPES || event.gridSize > MAX_GRID_SIZE) {
+        badEvents++;
+        return;
+    }
+    SizeStats& stats = sizes[event.gridSize];
+    stats.counts[event.type]++;
+
+    SessionState& session = sessions[event.session];
+    if (event.type == EVENT_START) {
+        session.roundStart = event.time;
+        session.lastMove = event.time;
+    } else if (event.type == EVENT_MOVE || event.type == EVENT_UNDO) {
+        if (session.lastMove != 0 && event.time >= session.lastMove) {
+            unsigned long long gap = event.time - session.lastMove;
+            if (gap < idleLimit) stats.moveTime.record(gap);
+            else stats.idleGaps++;
+        }
+        session.lastMove = event.time;
+    } else if (event.type == EVENT_WIN && session.roundStart != 0 && event.time >= session.roundStart) {
+        stats.solveTime.record((event.time - session.roundStart) / 1000);
+        session.roundStart = 0;
+    }
+}
+
+// Read one log file in large blocks
+// Returns false if it is missing or not an event log
+bool readLog(string filename) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == NULL) return false;
+
+    unsigned char header[EVENT_LOG_HEADER];
+    if (fread(header, 1, EVENT_LOG_HEADER, file) != EVENT_LOG_HEADER || !isEventLogHeader(header)) {
+        cout << filename << ": not an event log\n";
+        fclose(file);
+        return false;
+    }
+
+    vector<unsigned char> block((size_t)READ_RECORDS * EVENT_RECORD_SIZE);
+    GameEvent event;
+    while (true) {
+        size_t records = fread(block.data(), EVENT_RECORD_SIZE, READ_RECORDS, file);
+        for (size_t r = 0; r < records; r++) {
+            decodeEvent(block.data() + r * EVENT_RECORD_SIZE, event);
+            addEvent(event);
+        }
+        if (records < READ_RECORDS) break;
+    }
+    fclose(file);
+    return true;
+}
+
+// Milliseconds with one decimal from microseconds
+string millis(unsigned long long micros) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.1f", micros / 1000.0);
+    return text;
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> files;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--idle-ms" && i + 1 < argc) idleLimit = atoll(argv[++i]) * 1000;
+        else files.push_back(arg);
+    }
+    if (files.empty()) {
+        for (int age = EVENT_LOG_KEEP; age >= 0; age--) files.push_back(eventLogName(EVENT_LOG_FILE, age));
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int filesRead = 0;
+    for (int i = 0; i < (int)files.size(); i++) {
+        if (readLog(files[i])) filesRead++;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (filesRead == 0) {
+        cout << "No event logs found\n";
+        return 1;
+    }
+    cout << totalEvents << " events, " << sessions.size() << " sessions, " << filesRead << " files read in "
+         << fixed << setprecision(3) << seconds << " s";
+    if (seconds > 0) cout << " (" << setprecision(1) << totalEvents / seconds / 1e6 << " M events/s)";
+    cout << "\n";
+    if (badEvents > 0) cout << badEvents << " events with an unknown type or grid size skipped\n";
+
+    // Event counts per grid size
+    cout << "\n  " << left << setw(6) << "grid" << right;
+    for (int t = 0; t < NUM_EVENT_TYPES; t++) cout << setw(10) << eventNames[t];
+    cout << setw(10) << "win rate" << "\n";
+    for (int size = 0; size <= MAX_GRID_SIZE; size++) {
+        SizeStats& stats = sizes[size];
+        if (stats.counts[EVENT_START] == 0 && stats.counts[EVENT_MOVE] == 0) continue;
+
+        cout << "  " << left << setw(6) << (to_string(size) + "x" + to_string(size)) << right;
+        for (int t = 0; t < NUM_EVENT_TYPES; t++) cout << setw(10) << stats.counts[t];
+        double rounds = stats.counts[EVENT_START];
+        cout << setw(9) << setprecision(1) << (rounds > 0 ? 100.0 * stats.counts[EVENT_WIN] / rounds : 0.0) << "%\n";
+    }
+
+    // Timing per grid size
+    cout << "\n  " << left << setw(6) << "grid" << right << setw(10) << "gaps" << setw(10) << "idle"
+         << setw(12) << "move p50" << setw(10) << "p90" << setw(10) << "p99" << setw(12) << "solve p50" << setw(10) << "p90" << "\n";
+    for (int size = 0; size <= MAX_GRID_SIZE; size++) {
+        SizeStats& stats = sizes[size];
+        if (stats.moveTime.getCount() == 0 && stats.solveTime.getCount() == 0) continue;
+
+        cout << "  " << left << setw(6) << (to_string(size) + "x" + to_string(size)) << right
+             << setw(10) << stats.moveTime.getCount() << setw(10) << stats.idleGaps
+             << setw(10) << millis(stats.moveTime.percentile(0.50)) << "ms"
+             << setw(8) << millis(stats.moveTime.percentile(0.90)) << "ms"
+             << setw(8) << millis(stats.moveTime.percentile(0.99)) << "ms"
+             << setw(11) << setprecision(1) << stats.solveTime.percentile(0.50) / 1000.0 << "s"
+             << setw(9) << stats.solveTime.percentile(0.90) / 1000.0 << "s\n";
+    }
+    return 0;
+}
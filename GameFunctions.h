@@ -1,4 +1,4 @@
-// Core game logic and functions
+// Console screens and the main game loop
 #ifndef GAMEFUNCTIONS_H
 #define GAMEFUNCTIONS_H
 
@@ -7,28 +7,70 @@
 #include <conio.h>
 #include <windows.h>
 #include <iomanip>
-#include "DoublyLinkedList.h"
+#include "Grid.h"
 #include "Stack.h"
 #include "BST.h"
 #include "Display.h"
+#include "GlyphAtlas.h"
+#include "Themes.h"
+#include "GameSession.h"
+#include "Snapshot.h"
+#include "Profiler.h"
+#include "BackgroundSolver.h"
+#include "InputQueue.h"
+#include "Opponent.h"
+#include "EventLog.h"
+#include "Replay.h"
 
 using namespace std;
 
+#define AUTOSAVE_FILE "autosave.dat"    // Game in progress, saved after every move
+#define PROFILE_FILE "profile.txt"      // Timing dump ([P] in game, and on exit)
+#define SOLVER_NODE_BUDGET 200000000    // Background solves give up after this many nodes
+#define INPUT_POLL_MS 5                 // How often the game loop checks for solver results
+#define FRAME_INTERVAL_MS 16            // At most one frame per display interval (~60 Hz)
+#define RACE_GAP 4                      // Columns between the two boards in race mode
+
 // External references to global variables (defined in main.cpp)
-extern DoublyLinkedList currentGrid;
-extern DoublyLinkedList targetGrid;
-extern DoublyLinkedList savedGrid;
-extern Stack moveHistory;
 extern BST leaderboard;
-extern int gridSize;
-extern int emptyRow, emptyCol;
-extern int moves;
-extern int currentTheme;
-extern string themes[5];
-extern string emojis[5][25];
+extern GlyphAtlas glyphAtlas[NUM_THEMES + 1];
 
+// Clear the console with escape codes (same as "cls" without starting a process)
 void clearScreen() {
-    system("cls");
+    cout << "\033[2J\033[3J\033[H";
+}
+
+// Next key that is not an arrow key (arrows left over from playing are skipped)
+char readKey(InputThread& input) {
+    KeyEvent event;
+    while (true) {
+        while (input.pop(event)) {
+            if (!event.arrow) return event.key;
+        }
+        input.waitForKey(INPUT_POLL_MS * 20);
+    }
+}
+
+// Keep a message on screen for a while without blocking input
+// Any key (other than an arrow) ends the pause early
+void pauseScreen(InputThread& input, int milliseconds) {
+    ScopedTimer timer(PROBE_SCREEN_PAUSE);
+    chrono::steady_clock::time_point end = chrono::steady_clock::now() + chrono::milliseconds(milliseconds);
+
+    KeyEvent event;
+    while (chrono::steady_clock::now() < end) {
+        while (input.pop(event)) {
+            if (!event.arrow) return;
+        }
+        int left = chrono::duration_cast<chrono::milliseconds>(end - chrono::steady_clock::now()).count();
+        input.waitForKey(left > 0 ? left : 0);
+    }
+}
+
+// Save the game in progress so it can be resumed
+void autosave(GameSession& game) {
+    ScopedTimer timer(PROBE_SAVE);
+    saveSnapshotFile(game, AUTOSAVE_FILE);
 }
 
 // Move cursor up and clear previous line
@@ -37,168 +79,208 @@ void clearPreviousLine() {
     cout << "\033[A\033[2K\r";
 }
 
-// Randomize array order using Fisher-Yates shuffle algorithm
-void shuffleEmojis(string arr[], int count) {
-    for (int i = count - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        string temp = arr[i];
-        arr[i] = arr[j];
-        arr[j] = temp;
+// Build the pre-rendered cells of every theme (called once at startup)
+void buildGlyphAtlases() {
+    for (int t = 0; t < NUM_THEMES; t++) {
+        glyphAtlas[t].build(emojis[t], themeSize(t));
     }
+
+    string numbers[MAX_TILES];
+    for (int i = 0; i < MAX_TILES; i++) {
+        numbers[i] = to_string(i + 1);
+    }
+    glyphAtlas[NUMBERS_THEME].build(numbers, MAX_TILES);
 }
 
-// GRID MANAGEMENT FUNCTIONS
-
-// Initialize the game grid with emojis
-// newPattern: true = generate new puzzle, false = reuse saved puzzle (for retry)
-void initializeGrid(bool newPattern) {
-    currentGrid.clear();
-    targetGrid.clear();
-
-    if (newPattern) {
-        // Select random theme based on grid size
-        // 3x3: all themes available
-        // 4x4/5x5: exclude Moon Phases theme (not enough emojis)
-        if (gridSize == 3) {
-            currentTheme = rand() % 5;
-        } else {
-            int themeOptions[] = {0, 1, 3, 4}; // Emotion, Fruits, Foods, Animals
-            currentTheme = themeOptions[rand() % 4];
-        }
+// What the background solver knows about the current position
+struct HintState {
+    bool solving;                           // Waiting for the solver
+    int length;                             // Moves left on path (SOLVE_GAVE_UP if too hard)
+    int lowerBound;                         // Fewest moves the board could need
+    bool final;                             // The solver will not find a shorter path
+    unsigned char path[SOLVE_MAX_LENGTH];   // Best moves known (move codes)
+    int step;                               // Moves of path already played
+    bool visible;                           // Show the next move ([H] toggles)
+
+    HintState() : solving(false), length(SOLVE_GAVE_UP), lowerBound(0), final(true), step(0), visible(false) {}
+};
+
+// Get the target pattern of a game in solver form
+void packTarget(GameSession& game, BoardTarget& target) {
+    unsigned char tiles[MAX_CELLS];
+    packBoard(game.targetGrid, game.gridSize, tiles);
+    setTarget(target, tiles, game.gridSize);
+}
 
-        // Select required number of emojis
-        int needed = gridSize * gridSize - 1;  // -1 for empty space
-        string selected[25];
-        for (int i = 0; i < needed; i++) {
-            selected[i] = emojis[currentTheme][i];
-        }
-        selected[needed] = "";  // Empty space
-
-        // Randomize emoji positions
-        shuffleEmojis(selected, needed);
-
-        // Store initial pattern in all three grids
-        savedGrid.clear();
-        int index = 0;
-        for (int i = 0; i < gridSize; i++) {
-            for (int j = 0; j < gridSize; j++) {
-                targetGrid.insert(i, j, selected[index]);
-                savedGrid.insert(i, j, selected[index]);
-                currentGrid.insert(i, j, selected[index]);
-
-                // Track empty space position
-                if (selected[index] == "") {
-                    emptyRow = i;
-                    emptyCol = j;
-                }
-                index++;
-            }
-        }
-    } else {
-        // Reuse saved pattern for retry
-        for (int i = 0; i < gridSize; i++) {
-            for (int j = 0; j < gridSize; j++) {
-                string emoji = savedGrid.getEmoji(i, j);
-                targetGrid.insert(i, j, emoji);
-                currentGrid.insert(i, j, emoji);
-
-                if (emoji == "") {
-                    emptyRow = i;
-                    emptyCol = j;
-                }
-            }
-        }
+// Pack the board the round started from by undoing the move history on a copy
+// Returns false if the history does not reach back to the start (resumed game)
+bool packStartBoard(GameSession& game, unsigned char* board) {
+    string history = game.moveHistory.getDirections();
+    if ((int)history.length() != game.moves) return false;
+
+    packBoard(game.currentGrid, game.gridSize, board);
+    int blank = game.emptyRow * game.gridSize + game.emptyCol;
+    for (int i = (int)history.length() - 1; i >= 0; i--) {
+        int previous = blankAfterMove(blank, directionCode(history[i]) ^ 1, game.gridSize);
+        board[blank] = board[previous];
+        board[previous] = 0;
+        blank = previous;
     }
+    return true;
 }
 
-// Shuffle the grid using random valid moves
-// This ensures the puzzle is always solvable (every shuffle move can be reversed)
-void shuffleGrid() {
-    int shuffles = gridSize * gridSize * 20;  // More shuffles for larger grids
+// Start solving the current position in the background
+void requestHint(HintState& hint, BackgroundSolver& solver, GameSession& game, BoardTarget& target) {
+    unsigned char board[MAX_CELLS];
+    packBoard(game.currentGrid, game.gridSize, board);
+    hint.solving = true;
+    solver.submit(target, board);
+}
 
-    for (int i = 0; i < shuffles; i++) {
-        int dir = rand() % 4;
-        int newRow = emptyRow, newCol = emptyCol;
+// Update the hint after the player moved
+// Following a finished solution just advances it, any other move starts a new solve
+// (so does following a path the solver is still improving: its next answer would be for the old board)
+void followMove(HintState& hint, BackgroundSolver& solver, GameSession& game, BoardTarget& target, char direction) {
+    if (!hint.solving && hint.final && hint.length > 0 && directionCode(direction) == hint.path[hint.step]) {
+        hint.step++;
+        hint.length--;
+        if (hint.lowerBound > 0) hint.lowerBound--;
+        return;
+    }
+    requestHint(hint, solver, game, target);
+}
 
-        // Try to move in random direction
-        if (dir == 0 && emptyRow > 0) newRow--;                     // Up
-        else if (dir == 1 && emptyRow < gridSize - 1) newRow++;     // Down
-        else if (dir == 2 && emptyCol > 0) newCol--;                // Left
-        else if (dir == 3 && emptyCol < gridSize - 1) newCol++;     // Right
+// Take a finished solve from the solver (never waits)
+// Returns true if the hint changed
+bool receiveHint(HintState& hint, BackgroundSolver& solver) {
+    SolveAnswer answer;
+    if (!solver.poll(answer)) return false;
+
+    hint.solving = false;
+    hint.length = answer.length;
+    hint.lowerBound = answer.lowerBound;
+    hint.final = answer.final;
+    hint.step = 0;
+    if (answer.length > 0) memcpy(hint.path, answer.path, answer.length);
+    return true;
+}
 
-        // Swap empty space with adjacent emoji
-        string emptyEmoji = currentGrid.getEmoji(emptyRow, emptyCol);
-        string newEmoji = currentGrid.getEmoji(newRow, newCol);
+// DISPLAY FUNCTIONS
 
-        currentGrid.setEmoji(emptyRow, emptyCol, newEmoji);
-        currentGrid.setEmoji(newRow, newCol, emptyEmoji);
+// Append a boxed grid to the frame buffer using the current theme's atlas
+void renderBoard(string& frame, GameSession& game, Grid& grid) {
+    GlyphAtlas& atlas = glyphAtlas[game.currentTheme];
+    int gridSize = game.gridSize;
 
-        emptyRow = newRow;
-        emptyCol = newCol;
+    int rowWidth = atlas.cellWidth() * gridSize;
+
+    for (int i = 0; i < gridSize; i++) {
+        centerGrid(frame, rowWidth);
+        for (int j = 0; j < gridSize; j++) {
+            frame += atlas.top();
+        }
+
+        centerGrid(frame, rowWidth);
+        for (int j = 0; j < gridSize; j++) {
+            frame += atlas.cell(grid.getTile(i, j));
+        }
+
+        centerGrid(frame, rowWidth);
+        for (int j = 0; j < gridSize; j++) {
+            frame += atlas.bottom();
+        }
     }
 }
 
-// DISPLAY FUNCTIONS
+// Append the player's and the opponent's boards side by side (race mode)
+void renderRaceBoards(string& frame, GameSession& game, const unsigned char* opponentBoard) {
+    GlyphAtlas& atlas = glyphAtlas[game.currentTheme];
+    int gridSize = game.gridSize;
+
+    int boardWidth = atlas.cellWidth() * gridSize;
+    int rowWidth = boardWidth * 2 + RACE_GAP;
+    string gap(RACE_GAP, ' ');
+
+    centerGrid(frame, rowWidth);
+    frame += "YOU" + string(boardWidth - 3, ' ') + gap + "CPU";
+
+    for (int i = 0; i < gridSize; i++) {
+        centerGrid(frame, rowWidth);
+        for (int j = 0; j < gridSize; j++) frame += atlas.top();
+        frame += gap;
+        for (int j = 0; j < gridSize; j++) frame += atlas.top();
+
+        centerGrid(frame, rowWidth);
+        for (int j = 0; j < gridSize; j++) frame += atlas.cell(game.currentGrid.getTile(i, j));
+        frame += gap;
+        for (int j = 0; j < gridSize; j++) frame += atlas.cell(opponentBoard[i * gridSize + j]);
+
+        centerGrid(frame, rowWidth);
+        for (int j = 0; j < gridSize; j++) frame += atlas.bottom();
+        frame += gap;
+        for (int j = 0; j < gridSize; j++) frame += atlas.bottom();
+    }
+}
 
 // Display the current game state
 // Shows: target pattern (top), control instructions, current grid (bottom)
-void displayGrid() {
+// In race mode (opponentBoard set) the opponent's board is drawn beside the player's
+void displayGrid(GameSession& game, const unsigned char* opponentBoard = NULL, int opponentMoves = 0) {
+    ScopedTimer timer(PROBE_RENDER);
+    int gridSize = game.gridSize;
+
     clearScreen();
     displayGameHeader();
     displayDifficultyHeader(gridSize);
     
-    cout << " Theme: " << themes[currentTheme] << "\n";
-    cout << " Moves: " << moves;
+    cout << " Theme: " << themes[game.currentTheme] << "\n";
+    cout << " Moves: " << game.moves;
+    if (opponentBoard != NULL) cout << "      CPU Moves: " << opponentMoves;
+
+    // Build the rest of the frame in one buffer and write it once
+    GlyphAtlas& atlas = glyphAtlas[game.currentTheme];
+    string frame = "\n\n\033[0m";
 
     // Display target pattern (what player needs to match)
-    cout << "\n\n\033[0m";    
+    int indent = (74 - atlas.targetWidth() * gridSize) / 2;
+    if (indent < 0) indent = 0;
+
     for (int i = 0; i < gridSize; i++) {
-        if (gridSize == 3) {
-            cout << "\t\t\t\t";
-        } else if (gridSize == 4) {
-            cout << "\t\t\t       ";
-        } else if (gridSize == 5) {
-            cout << "\t\t\t     ";
-        }
+        frame.append(indent, ' ');
 
         for (int j = 0; j < gridSize; j++) {
-            string emoji = targetGrid.getEmoji(i, j);
-            
-            if (emoji == "") {
-                cout << "   ";
-            } else {
-                cout << emoji << " ";
-            }
+            frame += atlas.target(game.targetGrid.getTile(i, j));
         }
-        cout << "\n";
+        frame += "\n";
     }
 
+    cout << frame;
     setDifficultyColor(gridSize);
 
     // Display current puzzle state (with boxes)
-    for (int i = 0; i < gridSize; i++) {
-        centerGrid(gridSize);
-        for (int j = 0; j < gridSize; j++) {
-            cout << "┌────┐ ";
-        }
-
-        centerGrid(gridSize);
-        for (int j = 0; j < gridSize; j++) {
-            string emoji = currentGrid.getEmoji(i, j);
-            
-            if (emoji == "") {
-                cout << "│" << left << setw(4) << "" << "│ ";
-            } else {
-                cout << "│ " << left << setw(2) << emoji << " │ ";
-            }
-        }
+    frame.clear();
+    if (opponentBoard != NULL) renderRaceBoards(frame, game, opponentBoard);
+    else renderBoard(frame, game, game.currentGrid);
+    frame += "\n";
+    cout << frame;
+}
 
-        centerGrid(gridSize);
-        for (int j = 0; j < gridSize; j++) {
-            cout << "└────┘ ";
+// Write the solver line below the grid (redrawn in place when a result arrives)
+void displayHint(HintState& hint) {
+    static const char* arrows[4] = {"↑", "↓", "←", "→"};
+
+    cout << "\r\033[2K Moves left: ";
+    if (hint.solving) cout << "solving...";
+    else if (hint.length == SOLVE_GAVE_UP) cout << "too many to count";
+    else {
+        cout << hint.length;
+        if (hint.lowerBound < hint.length) cout << " (best ≥ " << hint.lowerBound << ")";
+        if (hint.length > 0) {
+            if (hint.visible) cout << "     Hint: " << arrows[hint.path[hint.step]];
+            else cout << "     [H] Hint";
         }
     }
-    cout << "\n";
+    cout << flush;
 }
 
 // Display leaderboard screen
@@ -219,127 +301,56 @@ void displayLeaderboard() {
     _getch();
 }
 
-// GAME LOGIC FUNCTIONS
-
-// Check if puzzle is solved
-// Compares current grid with target pattern
-bool isSolved() {
-    for (int i = 0; i < gridSize; i++) {
-        for (int j = 0; j < gridSize; j++) {
-            if (currentGrid.getEmoji(i, j) != targetGrid.getEmoji(i, j)) {
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
-// Execute a move in the puzzle
-// direction: Arrow key code from _getch() (72=Up, 80=Down, 75=Left, 77=Right)
-// Swaps empty space with adjacent emoji if move is valid
-void makeMove(char direction) {
-    int newRow = emptyRow, newCol = emptyCol;
-
-    // Calculate new empty position based on arrow key
-    if (direction == 72 && emptyRow < gridSize - 1) newRow++;      // Up arrow
-    else if (direction == 80 && emptyRow > 0) newRow--;            // Down arrow
-    else if (direction == 75 && emptyCol < gridSize - 1) newCol++; // Left arrow
-    else if (direction == 77 && emptyCol > 0) newCol--;            // Right arrow
-    else return;  // Invalid move
-
-    // Swap empty space with target emoji
-    string emptyEmoji = currentGrid.getEmoji(emptyRow, emptyCol);
-    string newEmoji = currentGrid.getEmoji(newRow, newCol);
-
-    currentGrid.setEmoji(emptyRow, emptyCol, newEmoji);
-    currentGrid.setEmoji(newRow, newCol, emptyEmoji);
-
-    // Save move to history for undo functionality
-    moveHistory.push(direction, ++moves);
-
-    emptyRow = newRow;
-    emptyCol = newCol;
-}
-
-// Undo the last move
-// Pops direction from stack and reverses the move
-void undoMove() {
-    if (moveHistory.isEmpty()) return;
-
-    char lastDirection = moveHistory.pop();
-    moves--;
-
-    int newRow = emptyRow, newCol = emptyCol;
-
-    // Reverse the last move
-    if (lastDirection == 72) newRow--;
-    else if (lastDirection == 80) newRow++;
-    else if (lastDirection == 75) newCol--;
-    else if (lastDirection == 77) newCol++;
-
-    // Swap back
-    string emptyEmoji = currentGrid.getEmoji(emptyRow, emptyCol);
-    string newEmoji = currentGrid.getEmoji(newRow, newCol);
-
-    currentGrid.setEmoji(emptyRow, emptyCol, newEmoji);
-    currentGrid.setEmoji(newRow, newCol, emptyEmoji);
-
-    emptyRow = newRow;
-    emptyCol = newCol;
-}
-
 // UI SCREEN FUNCTIONS
 
 // Display win screen and get player's choice
-char showWinScreen() {
+// optimalSolver: background solve of the round's starting board
+char showWinScreen(GameSession& game, BackgroundSolver& optimalSolver, InputThread& input) {
+    int gridSize = game.gridSize;
+    int moves = game.moves;
+
     clearScreen();
     logo();
     displayCongratulations();
-    Sleep(2000);
+    input.discard();        // Keys still held from the last moves
+    pauseScreen(input, 2000);
     clearScreen();
 
+    // Use the optimal length only if the solve has finished by now
+    // (large boards may only have a solution that is not proven optimal yet)
+    string optimal = "not known";
+    SolveAnswer answer;
+    if (optimalSolver.poll(answer) && answer.length != SOLVE_GAVE_UP) {
+        optimal = to_string(answer.length);
+        if (answer.lowerBound < answer.length) optimal = "at most " + optimal;
+    }
+    optimalSolver.cancel();
+
     displayWinHeader();
 
     // Display solved grid
-    for (int i = 0; i < gridSize; i++) {
-        centerGrid(gridSize);
-        for (int j = 0; j < gridSize; j++) {
-            cout << "┌────┐ ";
-        }
-
-        centerGrid(gridSize);
-        for (int j = 0; j < gridSize; j++) {
-            string emoji = currentGrid.getEmoji(i, j);
-            
-            if (emoji == "") {
-                cout << "│" << left << setw(4) << "" << "│ ";
-            } else {
-                cout << "│ " << left << setw(2) << emoji << " │ ";
-            }
-        }
-
-        centerGrid(gridSize);
-        for (int j = 0; j < gridSize; j++) {
-            cout << "└────┘ ";
-        }
-    }
+    string frame = "";
+    renderBoard(frame, game, game.currentGrid);
+    cout << frame;
 
     // Display statistics
     displayStatisticsHeader();
-    cout << "\t ║ Theme: " << left << setw(44) << themes[currentTheme] << "║\n";
+    cout << "\t ║ Theme: " << left << setw(44) << themes[game.currentTheme] << "║\n";
     displayDifficultyInStats(gridSize);
     cout << "\t ║ Total Moves: " << left << setw(38) << moves << "║\n";
+    cout << "\t ║ Optimal Moves: " << left << setw(36) << optimal << "║\n";
     displayEfficiencyRating(moves, gridSize);
     displayStatisticsFooter();
     
     // Ask to save score
-    cout << "\t\t  💾 Save to Leaderboard? " Y "[Y]" C " / " G "[N]" C ": ";
-    char saveChoice = _getch();
+    cout << "\t\t  💾 Save to Leaderboard? " Y "[Y]" C " / " G "[N]" C ": " << flush;
+    char saveChoice = readKey(input);
     cout << (char)toupper(saveChoice) << "\n";
 
+    string playerName = "";     // Stays empty if the score is not saved
     if (saveChoice == 'y' || saveChoice == 'Y') {
         clearPreviousLine();
-        string playerName;
+        input.pause();      // getline() reads the console itself
         cout << "\n                Enter your name (max 17 chars): ";
         getline(cin, playerName);
 
@@ -363,24 +374,31 @@ char showWinScreen() {
 
             break; // input is valid
         }
+        input.resume();
 
         if (playerName.empty()) playerName = "Anonymous";
         if (playerName.length() > 17) playerName = playerName.substr(0, 17);
 
-        leaderboard.insert(playerName, moves, gridSize, themes[currentTheme]);
-        leaderboard.saveToFile("leaderboard.txt");
+        leaderboard.insert(playerName, moves, gridSize, themes[game.currentTheme]);
+        {
+            ScopedTimer timer(PROBE_LEADERBOARD_IO);
+            leaderboard.saveToFile("leaderboard.txt");
+        }
 
         clearPreviousLine();
         cout << "\n\t ✅ 𝐒 𝐂 𝐎 𝐑 𝐄   𝐒 𝐀 𝐕 𝐄 𝐃   𝐓 𝐎   𝐋 𝐄 𝐀 𝐃 𝐄 𝐑 𝐁 𝐎 𝐀 𝐑 𝐃 \n\n";
-        Sleep(1500);
+        pauseScreen(input, 1500);
     }
 
+    // Keep the game for offline analysis (ReplayStats.cpp)
+    appendReplay(REPLAY_FILE, playerName, game);
+
     // Show options
     clearPreviousLine();
-    cout << "        [N] Next Level      [R] Retry Level      [B] Back to Menu \n";
+    cout << "        [N] Next Level      [R] Retry Level      [B] Back to Menu \n" << flush;
 
     while (true) {
-        char choice = _getch();
+        char choice = readKey(input);
         if (choice == 'n' || choice == 'N') return 'N';
         if (choice == 'r' || choice == 'R') return 'R';
         if (choice == 'b' || choice == 'B') return 'B';
@@ -395,76 +413,332 @@ void showSplash() {
 }
 
 // Show main menu and get user choice
-// Returns: 0=Exit, 1=Easy, 2=Medium, 3=Hard, 4=Leaderboard
+// Returns: 0=Exit, 1=Easy, 2=Medium, 3=Hard, 4=Leaderboard, 5=Custom, 6=Resume, 7=Race
 int showMenu() {
     clearScreen();
     displayMainMenu();
 
     while (true) {
         char choice = _getch();
-        if (choice >= '0' && choice <= '4') {
+        if (choice >= '0' && choice <= '7') {
             return choice - '0';
         }
     }
 }
 
+// Ask the player for a custom grid size
+// Keeps asking until the size is between MIN_GRID_SIZE and MAX_GRID_SIZE
+int askGridSize() {
+    string input;
+    cout << "                Enter grid size (" << MIN_GRID_SIZE << "-" << MAX_GRID_SIZE << "): ";
+    getline(cin, input);
+
+    while (true) {
+        int size = atoi(input.c_str());
+        if (size >= MIN_GRID_SIZE && size <= MAX_GRID_SIZE) {
+            return size;
+        }
+
+        clearPreviousLine();
+        cout << "\n                Enter grid size (" << MIN_GRID_SIZE << "-" << MAX_GRID_SIZE << "): ";
+        getline(cin, input);
+    }
+}
+
 // Main game loop
+// difficulty: 1=Easy (3x3), 2=Medium (4x4), 3=Hard (5x5), 5=Custom (asks for size),
+//             6=Resume the autosaved game
 void playGame(int difficulty) {
+    GameSession game;
+    bool resumed = false;      // Continue the loaded game instead of starting a new one
+
     // Set grid size based on difficulty
-    if (difficulty == 1) gridSize = 3;
-    else if (difficulty == 2) gridSize = 4;
-    else if (difficulty == 3) gridSize = 5;
+    if (difficulty == 1) game.gridSize = 3;
+    else if (difficulty == 2) game.gridSize = 4;
+    else if (difficulty == 3) game.gridSize = 5;
+    else if (difficulty == 5) game.gridSize = askGridSize();
+    else {
+        resumed = loadSnapshotFile(game, AUTOSAVE_FILE);
+        if (!resumed) {
+            cout << "\t\t\t      No saved game to resume.\n";
+            Sleep(1500);
+            return;
+        }
+    }
 
     bool keepPlaying = true;
     bool samePattern = false;  // Track if retrying same puzzle
 
+    // Keys are read on their own thread; the loop below applies every key that
+    // arrived since the last pass and then draws at most one frame per interval
+    InputThread input;
+    ProfileTime shownKeys[KEY_QUEUE_SIZE];      // Read times of keys not drawn yet
+    int shownCount = 0;
+
+    // Solvers run beside the game loop: one for the current position (hints),
+    // one for the starting board (optimal length on the win screen)
+    BackgroundSolver hintSolver(SOLVER_NODE_BUDGET);
+    BackgroundSolver optimalSolver(SOLVER_NODE_BUDGET);
+    BoardTarget target;
+    HintState hint;
+
+    // Every move, undo, retry, quit and win goes to the event log (written on its own thread)
+    EventLog eventLog;
+
     while (keepPlaying) {
         // Initialize new puzzle or retry current one
-        initializeGrid(!samePattern);
-        shuffleGrid();
-        moves = 0;
-        moveHistory.clear();
+        if (!resumed) {
+            startRound(game, !samePattern);
+            autosave(game);
+        }
+        resumed = false;
+
+        packTarget(game, target);
+        unsigned char startBoard[MAX_CELLS];
+        if (packStartBoard(game, startBoard)) optimalSolver.submit(target, startBoard);
+        else optimalSolver.cancel();
+        requestHint(hint, hintSolver, game, target);
+        eventLog.startRound(game);
+        input.discard();
+
+        bool redraw = true;         // Board changed since the last frame
+        bool solved = false;
+        chrono::steady_clock::time_point nextFrame = chrono::steady_clock::now();
 
         // Main gameplay loop
         while (true) {
-            displayGrid();
+            bool changed = false;   // Board changed by this batch of keys (needs a save)
+            bool endRound = false;
+
+            // Apply all pending keys (stop at a win, later keys belong to the win screen)
+            KeyEvent event;
+            while (!solved && !endRound && input.pop(event)) {
+                char key = event.key;
+                if (shownCount < KEY_QUEUE_SIZE) shownKeys[shownCount++] = event.time;
+
+                if (event.arrow) {
+                    bool moved;
+                    {
+                        ScopedTimer timer(PROBE_MOVE);
+                        moved = makeMove(game, key);
+                    }
+                    if (moved) {
+                        eventLog.record(game, EVENT_MOVE, key);
+                        followMove(hint, hintSolver, game, target, key);
+                        changed = true;
+
+                        ScopedTimer timer(PROBE_WIN_CHECK);
+                        solved = isSolved(game);
+                        if (solved) eventLog.record(game, EVENT_WIN);
+                    }
+                }
+                // Handle special keys
+                else if (key == 'u' || key == 'U') {
+                    bool undone;
+                    {
+                        ScopedTimer timer(PROBE_MOVE);
+                        undone = undoMove(game);
+                    }
+                    if (undone) {
+                        eventLog.record(game, EVENT_UNDO);
+                        requestHint(hint, hintSolver, game, target);
+                        changed = true;
+                    }
+                } else if (key == 'h' || key == 'H') {
+                    hint.visible = !hint.visible;
+                    redraw = true;
+                } else if (key == 'p' || key == 'P') {
+                    dumpProfile(PROFILE_FILE);     // Debug key: write timing stats
+                } else if (key == 'r' || key == 'R') {
+                    eventLog.record(game, EVENT_RETRY);
+                    samePattern = true;
+                    endRound = true;
+                } else if (key == 'q' || key == 'Q') {
+                    eventLog.record(game, EVENT_QUIT);
+                    keepPlaying = false;
+                    endRound = true;
+                }
+            }
+
+            // One save per batch instead of one per key
+            if (changed && !solved) autosave(game);
+            redraw = redraw || changed;
+            if (endRound) break;
+
+            // Draw the latest state once the display interval has passed (a win is shown at once)
+            chrono::steady_clock::time_point now = chrono::steady_clock::now();
+            if (redraw && (now >= nextFrame || solved)) {
+                displayGrid(game);
+                displayHint(hint);
+                for (int i = 0; i < shownCount; i++) profileRecord(PROBE_INPUT, shownKeys[i]);
+                shownCount = 0;
+                redraw = false;
+                nextFrame = now + chrono::milliseconds(FRAME_INTERVAL_MS);
+            } else if (receiveHint(hint, hintSolver)) {
+                displayHint(hint);
+            }
 
-            // Check win condition
-            if (isSolved()) {
-                char choice = showWinScreen();
+            if (solved) {
+                remove(AUTOSAVE_FILE);      // Nothing left to resume
+                hintSolver.cancel();
+                char choice = showWinScreen(game, optimalSolver, input);
 
                 if (choice == 'N') {
                     samePattern = false;  // Generate new puzzle
-                    break;
                 } else if (choice == 'R') {
                     samePattern = true;   // Retry same puzzle
-                    break;
-                } else if (choice == 'B') {
+                } else {
                     keepPlaying = false;  // Return to menu
-                    break;
                 }
+                break;
             }
 
-            // Get player input
-            char key = _getch();
-
-            // Handle arrow keys (require two _getch() calls)
-            if (key == -32 || key == 0) {
-                key = _getch();
-                makeMove(key);
-            } 
-            // Handle special keys
-            else if (key == 'u' || key == 'U') {
-                undoMove();
-            } else if (key == 'r' || key == 'R') {
-                samePattern = true;
-                break;
-            } else if (key == 'q' || key == 'Q') {
-                keepPlaying = false;
+            // Sleep until a key arrives, the next frame is due or it is time to check the solver
+            int wait = INPUT_POLL_MS;
+            if (redraw) {
+                int untilFrame = chrono::duration_cast<chrono::milliseconds>(nextFrame - now).count();
+                if (untilFrame < wait) wait = untilFrame > 0 ? untilFrame : 0;
+            }
+            input.waitForKey(wait);
+        }
+    }
+}
+
+// RACE MODE
+
+// Read a menu choice between 1 and options
+int askOption(int options) {
+    while (true) {
+        char choice = _getch();
+        if (choice >= '1' && choice < '1' + options) {
+            cout << choice << "\n\n";
+            return choice - '0';
+        }
+    }
+}
+
+// Show the race result and get player's choice
+char showRaceResult(GameSession& game, int opponentMoves, bool playerWon, InputThread& input) {
+    clearScreen();
+    logo();
+    displayRaceResult(playerWon);
+    input.discard();        // Keys still held from the last moves
+    pauseScreen(input, 1500);
+
+    displayStatisticsHeader();
+    displayDifficultyInStats(game.gridSize);
+    cout << "\t ║ Your Moves: " << left << setw(39) << game.moves << "║\n";
+    cout << "\t ║ CPU Moves: " << left << setw(40) << opponentMoves << "║\n";
+    displayStatisticsFooter();
+
+    cout << "        [N] New Race      [R] Rematch      [B] Back to Menu \n" << flush;
+    while (true) {
+        char choice = readKey(input);
+        if (choice == 'n' || choice == 'N') return 'N';
+        if (choice == 'r' || choice == 'R') return 'R';
+        if (choice == 'b' || choice == 'B') return 'B';
+    }
+}
+
+// Race a computer opponent on the same puzzle
+// The opponent plays on its own thread; its moves arrive through a queue
+// and are drawn beside the player's board
+void playRace() {
+    clearScreen();
+    displayRaceSetup();
+
+    cout << "                Grid ([1] 3x3  [2] 4x4  [3] 5x5): ";
+    int gridSize = askOption(3) + 2;
+    cout << "                Opponent ([1] Greedy  [2] Weighted  [3] Optimal): ";
+    int strength = askOption(3) - 1;
+    cout << "                Speed ([1] Slow  [2] Normal  [3] Fast): ";
+    int speeds[3] = {2, 4, 8};          // Opponent moves per second
+    int speed = speeds[askOption(3) - 1];
+
+    GameSession game;
+    game.gridSize = gridSize;
+    InputThread input;
+    bool keepRacing = true;
+    bool samePattern = false;
+
+    while (keepRacing) {
+        startRound(game, !samePattern);
+
+        // Both sides start from the same board; only the opponent's copy moves on its thread
+        RacePuzzle puzzle;
+        packTarget(game, puzzle.target);
+        packBoard(game.currentGrid, gridSize, puzzle.start);
+
+        unsigned char opponentBoard[MAX_CELLS];
+        memcpy(opponentBoard, puzzle.start, puzzle.target.cells);
+        int opponentBlank = game.emptyRow * gridSize + game.emptyCol;
+        int opponentMoves = 0;
+
+        Opponent opponent(puzzle, strength, speed, game.rng);
+        input.discard();
+
+        bool redraw = true;
+        int winner = 0;             // 1 = player, 2 = opponent
+        chrono::steady_clock::time_point nextFrame = chrono::steady_clock::now();
+
+        while (true) {
+            bool endRound = false;
+
+            KeyEvent event;
+            while (winner == 0 && !endRound && input.pop(event)) {
+                char key = event.key;
+                if (event.arrow) {
+                    if (makeMove(game, key)) {
+                        redraw = true;
+                        if (isSolved(game)) winner = 1;
+                    }
+                } else if (key == 'u' || key == 'U') {
+                    redraw = undoMove(game) || redraw;
+                } else if (key == 'r' || key == 'R') {
+                    samePattern = true;
+                    endRound = true;
+                } else if (key == 'q' || key == 'Q') {
+                    keepRacing = false;
+                    endRound = true;
+                }
+            }
+            if (endRound) break;
+
+            // Apply the opponent's moves to the board shown for it
+            int code;
+            while (winner == 0 && opponent.nextMove(code)) {
+                int next = blankAfterMove(opponentBlank, code, gridSize);
+                opponentBoard[opponentBlank] = opponentBoard[next];
+                opponentBoard[next] = 0;
+                opponentBlank = next;
+                opponentMoves++;
+                redraw = true;
+                if (memcmp(opponentBoard, puzzle.target.tiles, puzzle.target.cells) == 0) winner = 2;
+            }
+
+            chrono::steady_clock::time_point now = chrono::steady_clock::now();
+            if (redraw && (now >= nextFrame || winner != 0)) {
+                displayGrid(game, opponentBoard, opponentMoves);
+                redraw = false;
+                nextFrame = now + chrono::milliseconds(FRAME_INTERVAL_MS);
+            }
+
+            if (winner != 0) {
+                char choice = showRaceResult(game, opponentMoves, winner == 1, input);
+                if (choice == 'N') samePattern = false;
+                else if (choice == 'R') samePattern = true;
+                else keepRacing = false;
                 break;
             }
+
+            int wait = INPUT_POLL_MS;
+            if (redraw) {
+                int untilFrame = chrono::duration_cast<chrono::milliseconds>(nextFrame - now).count();
+                if (untilFrame < wait) wait = untilFrame > 0 ? untilFrame : 0;
+            }
+            input.waitForKey(wait);
         }
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,297 @@
+// Game Session: Puzzle state and core game logic (no console I/O)
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include "Grid.h"
+#include "Stack.h"
+#include "Themes.h"
+using namespace std;
+
+// Arrow key codes from _getch() (also used as move directions)
+#define KEY_UP 72
+#define KEY_DOWN 80
+#define KEY_LEFT 75
+#define KEY_RIGHT 77
+
+// All state of one game in progress
+// The console game uses one session, the server keeps one per player
+struct GameSession {
+    Grid currentGrid;               // Current puzzle state (what player sees)
+    Grid targetGrid;                // Target pattern to match
+    Grid savedGrid;                 // Saved initial pattern (for retry)
+    Stack moveHistory;              // History of moves (for undo)
+    int gridSize;                   // Current grid dimension (2 to 16)
+    int emptyRow, emptyCol;         // Position of empty space
+    int moves;                      // Current move count
+    int currentTheme;               // Current theme index
+    unsigned int seed;              // Seed the target pattern was generated from
+    unsigned int rng;               // Random state for this session's shuffles
+
+    GameSession() : gridSize(3), emptyRow(0), emptyCol(0), moves(0), currentTheme(0), seed(1), rng(1) {}
+};
+
+// Next random number of a session (xorshift32)
+unsigned int nextRandom(GameSession& game) {
+    unsigned int x = game.rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    game.rng = x;
+    return x;
+}
+
+// Randomize array order using Fisher-Yates shuffle algorithm
+void shuffleTiles(GameSession& game, int arr[], int count) {
+    for (int i = count - 1; i > 0; i--) {
+        int j = nextRandom(game) % (i + 1);
+        int temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+// Get the emoji of a tile ID in the given theme (0 = empty space)
+string tileEmoji(int theme, int tile) {
+    if (tile == 0) return "";
+    if (theme == NUMBERS_THEME) return to_string(tile);
+    return emojis[theme][tile - 1];
+}
+
+// Select a random theme with enough emojis for the grid size
+// Falls back to numbered tiles when no emoji theme is large enough
+int pickTheme(GameSession& game, int gridSize) {
+    int needed = gridSize * gridSize - 1;
+    int options[NUM_THEMES];
+    int count = 0;
+
+    for (int t = 0; t < NUM_THEMES; t++) {
+        if (themeSize(t) >= needed) {
+            options[count++] = t;
+        }
+    }
+
+    if (count == 0) return NUMBERS_THEME;
+    return options[nextRandom(game) % count];
+}
+
+// GRID MANAGEMENT FUNCTIONS
+
+// Pick the theme and tile order of game.seed (row by row, 0 = empty space)
+// The same seed and grid size always give the same puzzle
+void patternTiles(GameSession& game, int selected[]) {
+    game.rng = game.seed != 0 ? game.seed : 1;   // xorshift state must not be 0
+
+    // Select random theme based on grid size
+    // e.g. 3x3: all themes available
+    //      4x4/5x5: exclude Moon Phases theme (not enough emojis)
+    //      6x6 and up: numbered tiles
+    game.currentTheme = pickTheme(game, game.gridSize);
+
+    // Select required number of emojis (tile IDs 1..needed)
+    int needed = game.gridSize * game.gridSize - 1;  // -1 for empty space
+    for (int i = 0; i < needed; i++) {
+        selected[i] = i + 1;
+    }
+    selected[needed] = 0;  // Empty space
+
+    // Randomize emoji positions
+    shuffleTiles(game, selected, needed);
+}
+
+// Generate the theme and target pattern of game.seed into savedGrid
+void buildPattern(GameSession& game) {
+    int selected[MAX_CELLS];
+    patternTiles(game, selected);
+
+    game.savedGrid.resize(game.gridSize);
+    for (int c = 0; c < game.gridSize * game.gridSize; c++) {
+        game.savedGrid.setTile(c, selected[c]);
+    }
+}
+
+// Initialize the game grid with emojis
+// newPattern: true = generate new puzzle, false = reuse saved puzzle (for retry)
+void initializeGrid(GameSession& game, bool newPattern) {
+    if (newPattern) {
+        game.seed = ((unsigned int)rand() << 16) ^ (unsigned int)rand();
+        buildPattern(game);
+    }
+
+    // Copy the saved pattern into the target and current grids
+    game.targetGrid = game.savedGrid;
+    game.currentGrid = game.savedGrid;
+
+    for (int c = 0; c < game.gridSize * game.gridSize; c++) {
+        if (game.savedGrid.getTile(c) == 0) {
+            game.emptyRow = c / game.gridSize;
+            game.emptyCol = c % game.gridSize;
+        }
+    }
+}
+
+// Shuffle the grid using random valid moves
+// This ensures the puzzle is always solvable (every shuffle move can be reversed)
+void shuffleGrid(GameSession& game) {
+    int shuffles = game.gridSize * game.gridSize * 20;  // More shuffles for larger grids
+
+    for (int i = 0; i < shuffles; i++) {
+        int dir = nextRandom(game) % 4;
+        int newRow = game.emptyRow, newCol = game.emptyCol;
+
+        // Try to move in random direction
+        if (dir == 0 && game.emptyRow > 0) newRow--;                         // Up
+        else if (dir == 1 && game.emptyRow < game.gridSize - 1) newRow++;   // Down
+        else if (dir == 2 && game.emptyCol > 0) newCol--;                    // Left
+        else if (dir == 3 && game.emptyCol < game.gridSize - 1) newCol++;   // Right
+
+        // Swap empty space with adjacent emoji
+        game.currentGrid.swapCells(game.emptyRow * game.gridSize + game.emptyCol, newRow * game.gridSize + newCol);
+
+        game.emptyRow = newRow;
+        game.emptyCol = newCol;
+    }
+}
+
+// Start a new puzzle (or retry the saved one) and reset the move counter
+void startRound(GameSession& game, bool newPattern) {
+    initializeGrid(game, newPattern);
+    shuffleGrid(game);
+    game.moves = 0;
+    game.moveHistory.clear();
+}
+
+// GAME LOGIC FUNCTIONS
+
+// isSolved() for an N x N grid (constant-size compare the compiler inlines)
+template <int N>
+inline bool sameTilesFixed(const unsigned char* first, const unsigned char* second) {
+    return memcmp(first, second, N * N) == 0;
+}
+
+// Check if puzzle is solved
+// Compares current grid with target pattern, one pass over the cells
+// 3x3, 4x4 and 5x5 use the fixed-size compare, other sizes the general one
+bool isSolved(GameSession& game) {
+    const unsigned char* current = game.currentGrid.cells();
+    const unsigned char* target = game.targetGrid.cells();
+    switch (game.gridSize) {
+        case 3: return sameTilesFixed<3>(current, target);
+        case 4: return sameTilesFixed<4>(current, target);
+        case 5: return sameTilesFixed<5>(current, target);
+    }
+    return memcmp(current, target, game.gridSize * game.gridSize) == 0;
+}
+
+// Execute a move in the puzzle
+// direction: Arrow key code from _getch() (72=Up, 80=Down, 75=Left, 77=Right)
+// Swaps empty space with adjacent emoji if move is valid
+// Returns false if the move is not possible
+bool makeMove(GameSession& game, char direction) {
+    int newRow = game.emptyRow, newCol = game.emptyCol;
+
+    // Calculate new empty position based on arrow key
+    if (direction == KEY_UP && game.emptyRow < game.gridSize - 1) newRow++;
+    else if (direction == KEY_DOWN && game.emptyRow > 0) newRow--;
+    else if (direction == KEY_LEFT && game.emptyCol < game.gridSize - 1) newCol++;
+    else if (direction == KEY_RIGHT && game.emptyCol > 0) newCol--;
+    else return false;  // Invalid move
+
+    // Swap empty space with target emoji
+    game.currentGrid.swapCells(game.emptyRow * game.gridSize + game.emptyCol, newRow * game.gridSize + newCol);
+
+    // Save move to history for undo functionality
+    game.moveHistory.push(direction, ++game.moves);
+
+    game.emptyRow = newRow;
+    game.emptyCol = newCol;
+    return true;
+}
+
+// Undo the last move
+// Pops direction from stack and reverses the move
+// Returns false if there is nothing to undo
+bool undoMove(GameSession& game) {
+    if (game.moveHistory.isEmpty()) return false;
+
+    char lastDirection = game.moveHistory.pop();
+    game.moves--;
+
+    int newRow = game.emptyRow, newCol = game.emptyCol;
+
+    // Reverse the last move
+    if (lastDirection == KEY_UP) newRow--;
+    else if (lastDirection == KEY_DOWN) newRow++;
+    else if (lastDirection == KEY_LEFT) newCol--;
+    else if (lastDirection == KEY_RIGHT) newCol++;
+
+    // Swap back
+    game.currentGrid.swapCells(game.emptyRow * game.gridSize + game.emptyCol, newRow * game.gridSize + newCol);
+
+    game.emptyRow = newRow;
+    game.emptyCol = newCol;
+    return true;
+}
+
+// Free all grid and history memory of a session
+// (used when a session is parked or given back, not between rounds)
+void clearSession(GameSession& game) {
+    game.currentGrid.clear();
+    game.targetGrid.clear();
+    game.savedGrid.clear();
+    game.moveHistory.shrink();
+    game.moves = 0;
+}
+
+// Fixed pool of sessions allocated once as a single block
+// acquire() and release() are O(1) using a stack of free slot indices
+class SessionPool {
+    GameSession* slots;
+    int* freeSlots;
+    int freeCount;
+    int capacity;
+
+public:
+    SessionPool(int capacity) : capacity(capacity) {
+        slots = new GameSession[capacity];
+        freeSlots = new int[capacity];
+        freeCount = capacity;
+        for (int i = 0; i < capacity; i++) {
+            freeSlots[i] = capacity - 1 - i;
+        }
+    }
+
+    ~SessionPool() {
+        delete[] slots;
+        delete[] freeSlots;
+    }
+
+    // Take a free session (returns -1 if the pool is full)
+    int acquire() {
+        if (freeCount == 0) return -1;
+        return freeSlots[--freeCount];
+    }
+
+    // Give a session back to the pool and reset its state
+    void release(int id) {
+        clearSession(slots[id]);
+        freeSlots[freeCount++] = id;
+    }
+
+    GameSession& get(int id) {
+        return slots[id];
+    }
+
+    // Get number of sessions in use
+    int getActive() {
+        return capacity - freeCount;
+    }
+
+    int getCapacity() {
+        return capacity;
+    }
+};
+
+#endif
@@ -0,0 +1,161 @@
+// Glyph Atlas: Pre-rendered grid cells for each theme
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <string>
+#include "Grid.h"
+using namespace std;
+
+#define MAX_TILES (MAX_CELLS - 1)   // Tile IDs 1..MAX_TILES, 0 = empty space
+
+// Decode one UTF-8 character starting at index i (advances i)
+unsigned int decodeUTF8(const string& s, int& i) {
+    unsigned char c = s[i++];
+    int extra = 0;
+    unsigned int code = c;
+
+    if (c >= 0xF0) { code = c & 0x07; extra = 3; }
+    else if (c >= 0xE0) { code = c & 0x0F; extra = 2; }
+    else if (c >= 0xC0) { code = c & 0x1F; extra = 1; }
+
+    while (extra > 0 && i < (int)s.length()) {
+        code = (code << 6) | (s[i++] & 0x3F);
+        extra--;
+    }
+    return code;
+}
+
+// Terminal column width of a single code point (0, 1 or 2)
+int codePointWidth(unsigned int code) {
+    // Zero-width: combining marks, zero width joiner, variation selectors
+    if ((code >= 0x0300 && code <= 0x036F) || code == 0x200D ||
+        (code >= 0xFE00 && code <= 0xFE0F)) {
+        return 0;
+    }
+
+    // Wide: CJK, fullwidth forms and emoji blocks
+    if ((code >= 0x1100 && code <= 0x115F) ||
+        (code >= 0x2E80 && code <= 0xA4CF) ||
+        (code >= 0xAC00 && code <= 0xD7A3) ||
+        (code >= 0xF900 && code <= 0xFAFF) ||
+        (code >= 0xFF00 && code <= 0xFF60) ||
+        (code >= 0xFFE0 && code <= 0xFFE6) ||
+        (code >= 0x1F300 && code <= 0x1F64F) ||
+        (code >= 0x1F680 && code <= 0x1F6FF) ||
+        (code >= 0x1F900 && code <= 0x1F9FF) ||
+        (code >= 0x20000 && code <= 0x3FFFD)) {
+        return 2;
+    }
+    return 1;
+}
+
+// Measure how many terminal columns a UTF-8 string occupies
+// U+FE0F (emoji presentation) widens a narrow base character to 2 columns
+int displayWidth(const string& s) {
+    int width = 0;
+    int lastWidth = 0;
+    int i = 0;
+
+    while (i < (int)s.length()) {
+        unsigned int code = decodeUTF8(s, i);
+
+        if (code == 0xFE0F && lastWidth == 1) {
+            width++;
+            lastWidth = 2;
+            continue;
+        }
+
+        int w = codePointWidth(code);
+        if (w > 0) lastWidth = w;
+        width += w;
+    }
+    return width;
+}
+
+// Store the pre-encoded output bytes for every tile of one theme
+// Each cell already contains its box borders and padding,
+// so drawing a cell is a single append into the frame buffer
+class GlyphAtlas {
+    string cellMid[MAX_TILES + 1];      // "│ 😀 │ " per tile ID
+    string targetCell[MAX_TILES + 1];   // "😀 " per tile ID (target pattern)
+    int width[MAX_TILES + 1];           // Measured column width per tile ID
+    string cellTop;                     // "┌────┐ "
+    string cellBottom;                  // "└────┘ "
+    int slotWidth;                      // Columns reserved for each glyph
+    int tileCount;
+
+public:
+    GlyphAtlas() : slotWidth(2), tileCount(0) {
+        for (int i = 0; i <= MAX_TILES; i++) width[i] = 0;
+    }
+
+    // Build all cells for a theme (tile ID t uses glyphs[t - 1])
+    void build(const string glyphs[], int count) {
+        if (count > MAX_TILES) count = MAX_TILES;
+        tileCount = count;
+
+        // Every glyph is padded to the same slot width (at least 2 columns)
+        int slot = 2;
+        for (int t = 1; t <= count; t++) {
+            width[t] = displayWidth(glyphs[t - 1]);
+            if (width[t] > slot) slot = width[t];
+        }
+        slotWidth = slot;
+
+        string border = "";
+        for (int i = 0; i < slot + 2; i++) border += "─";
+        cellTop = "┌" + border + "┐ ";
+        cellBottom = "└" + border + "┘ ";
+
+        // Tile 0 is the empty space
+        width[0] = 0;
+        cellMid[0] = "│" + string(slot + 2, ' ') + "│ ";
+        targetCell[0] = string(slot + 1, ' ');
+
+        for (int t = 1; t <= count; t++) {
+            string pad(slot - width[t], ' ');
+            cellMid[t] = "│ " + glyphs[t - 1] + pad + " │ ";
+            targetCell[t] = glyphs[t - 1] + pad + " ";
+        }
+    }
+
+    // Pre-encoded middle row of a boxed cell
+    const string& cell(int tile) {
+        return cellMid[tile];
+    }
+
+    // Pre-encoded target pattern cell
+    const string& target(int tile) {
+        return targetCell[tile];
+    }
+
+    const string& top() {
+        return cellTop;
+    }
+
+    const string& bottom() {
+        return cellBottom;
+    }
+
+    // Columns taken by one boxed cell including the trailing gap
+    int cellWidth() {
+        return slotWidth + 5;
+    }
+
+    // Columns taken by one target pattern cell
+    int targetWidth() {
+        return slotWidth + 1;
+    }
+
+    // Get measured column width of a tile
+    int getWidth(int tile) {
+        return width[tile];
+    }
+
+    // Get number of tiles in this theme
+    int getSize() {
+        return tileCount;
+    }
+};
+
+#endif
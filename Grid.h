@@ -0,0 +1,72 @@
+// Grid: Stores the tiles of a board by cell (row * gridSize + col)
+#ifndef GRID_H
+#define GRID_H
+
+#include <cstring>
+using namespace std;
+
+#define MIN_GRID_SIZE 2     // Smallest supported grid (2x2)
+#define MAX_GRID_SIZE 16    // Largest supported grid (16x16)
+#define MAX_CELLS (MAX_GRID_SIZE * MAX_GRID_SIZE)
+
+// Tiles of one board, one byte per cell (tile ID, 0 = empty space)
+// Storage is sized for MaxSize x MaxSize, so any grid size up to that fits
+// and a session keeps the same grid from level to level
+// Reading, writing and swapping a cell are O(1)
+template <int MaxSize>
+class TileGrid {
+    unsigned char tiles[MaxSize * MaxSize];
+    int gridSize;
+    int size;           // Cells in use (gridSize * gridSize, 0 when cleared)
+
+public:
+    TileGrid() : gridSize(0), size(0) {}
+
+    // Start a gridSize x gridSize board (tiles are set with setTile())
+    void resize(int newSize) {
+        gridSize = newSize;
+        size = newSize * newSize;
+    }
+
+    // Get tile ID at specified position
+    int getTile(int row, int col) const {
+        return tiles[row * gridSize + col];
+    }
+
+    // Get tile ID of a cell
+    int getTile(int cell) const {
+        return tiles[cell];
+    }
+
+    // Set the tile ID of a cell
+    void setTile(int cell, int tile) {
+        tiles[cell] = (unsigned char)tile;
+    }
+
+    // Swap the contents of two cells (used for sliding moves)
+    void swapCells(int first, int second) {
+        unsigned char temp = tiles[first];
+        tiles[first] = tiles[second];
+        tiles[second] = temp;
+    }
+
+    // All cells row by row (a packed board, see BoardEval.h)
+    const unsigned char* cells() const {
+        return tiles;
+    }
+
+    // Remove all cells
+    void clear() {
+        gridSize = size = 0;
+    }
+
+    // Get total number of cells
+    int getSize() const {
+        return size;
+    }
+};
+
+// Grid of a game session (fits every supported grid size)
+typedef TileGrid<MAX_GRID_SIZE> Grid;
+
+#endif
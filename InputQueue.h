@@ -0,0 +1,104 @@
+// Input Queue: Reads the keyboard on its own thread and hands keys to the game loop
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <conio.h>
+#include <windows.h>
+#include "Profiler.h"
+#include "SpscQueue.h"
+using namespace std;
+
+#define KEY_QUEUE_SIZE 256      // Keys that can wait for the game loop (power of two)
+#define INPUT_IDLE_MS 1         // Keyboard check interval of the input thread
+
+// One keypress
+struct KeyEvent {
+    char key;           // Character, or arrow key code if arrow is true
+    bool arrow;         // Arrow keys arrive as two bytes and share codes with letters
+    ProfileTime time;   // When the key was read (for input-to-render latency)
+};
+
+// Keyboard reader thread feeding a SpscQueue
+// pause() stops reading so the game thread can use getline() / _getch() itself
+class InputThread {
+    thread reader;
+    SpscQueue<KeyEvent, KEY_QUEUE_SIZE> keys;
+    atomic<bool> stopping;
+    bool paused;                    // Guarded by readLock
+    mutex readLock;                 // Held while the reader is inside _kbhit() / _getch()
+    mutex wakeLock;
+    condition_variable wake;        // Signals the game thread that a key arrived
+
+    void run() {
+        while (!stopping.load()) {
+            KeyEvent event;
+            bool gotKey = false;
+            {
+                lock_guard<mutex> lock(readLock);
+                if (!paused && _kbhit()) {
+                    event.key = _getch();
+                    event.arrow = event.key == -32 || event.key == 0;
+                    if (event.arrow) event.key = _getch();
+                    event.time = profileNow();
+                    gotKey = true;
+                }
+            }
+
+            if (!gotKey) {
+                Sleep(INPUT_IDLE_MS);
+                continue;
+            }
+
+            while (!keys.push(event) && !stopping.load()) Sleep(INPUT_IDLE_MS);    // Full: wait for the game
+            {
+                lock_guard<mutex> lock(wakeLock);
+            }
+            wake.notify_one();
+        }
+    }
+
+public:
+    InputThread() : stopping(false), paused(false) {
+        reader = thread(&InputThread::run, this);
+    }
+
+    ~InputThread() {
+        stopping = true;
+        reader.join();
+    }
+
+    // Take the oldest unhandled key (never waits)
+    bool pop(KeyEvent& event) {
+        return keys.pop(event);
+    }
+
+    // Sleep until a key arrives or the time runs out
+    void waitForKey(int milliseconds) {
+        unique_lock<mutex> lock(wakeLock);
+        wake.wait_for(lock, chrono::milliseconds(milliseconds), [this] { return !keys.isEmpty(); });
+    }
+
+    // Throw away keys that were pressed but not handled yet
+    void discard() {
+        KeyEvent event;
+        while (keys.pop(event)) {}
+    }
+
+    // Stop reading the keyboard (returns once the reader is outside _getch())
+    void pause() {
+        lock_guard<mutex> lock(readLock);
+        paused = true;
+    }
+
+    void resume() {
+        lock_guard<mutex> lock(readLock);
+        paused = false;
+    }
+};
+
+#endif
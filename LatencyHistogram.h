@@ -0,0 +1,93 @@
+// Latency Histogram: Records timings and reports percentiles (p50/p99/max)
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#define HIST_SUB_BUCKETS 16                     // Sub-buckets per power of two (~6% precision)
+#define HIST_BUCKETS (61 * HIST_SUB_BUCKETS)    // Covers the full 64-bit range
+
+// Log-linear histogram of nanosecond values
+// Values below 16 are exact, larger values fall into 16 buckets per power of two
+class LatencyHistogram {
+    unsigned long long buckets[HIST_BUCKETS];
+    unsigned long long count;
+    unsigned long long total;
+    unsigned long long maxValue;
+
+    // Find the bucket of a value
+    static int bucketOf(unsigned long long value) {
+        if (value < HIST_SUB_BUCKETS) return (int)value;
+        int exponent = 63 - __builtin_clzll(value);     // >= 4
+        int sub = (int)((value >> (exponent - 4)) & (HIST_SUB_BUCKETS - 1));
+        return (exponent - 3) * HIST_SUB_BUCKETS + sub;
+    }
+
+    // Largest value that falls into a bucket
+    static unsigned long long bucketTop(int index) {
+        if (index < HIST_SUB_BUCKETS) return index;
+        int exponent = index / HIST_SUB_BUCKETS + 3;
+        unsigned long long sub = index % HIST_SUB_BUCKETS;
+        return ((HIST_SUB_BUCKETS + sub + 1) << (exponent - 4)) - 1;
+    }
+
+public:
+    LatencyHistogram() {
+        reset();
+    }
+
+    // Add one measurement
+    void record(unsigned long long value) {
+        buckets[bucketOf(value)]++;
+        count++;
+        total += value;
+        if (value > maxValue) maxValue = value;
+    }
+
+    // Add all measurements of another histogram
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < HIST_BUCKETS; i++) {
+            buckets[i] += other.buckets[i];
+        }
+        count += other.count;
+        total += other.total;
+        if (other.maxValue > maxValue) maxValue = other.maxValue;
+    }
+
+    // Value below which the given fraction of measurements fall (e.g. 0.99)
+    unsigned long long percentile(double fraction) {
+        if (count == 0) return 0;
+        unsigned long long rank = (unsigned long long)(fraction * count);
+        if (rank >= count) rank = count - 1;
+
+        unsigned long long seen = 0;
+        for (int i = 0; i < HIST_BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen > rank) {
+                unsigned long long top = bucketTop(i);
+                return top < maxValue ? top : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+    void reset() {
+        for (int i = 0; i < HIST_BUCKETS; i++) buckets[i] = 0;
+        count = 0;
+        total = 0;
+        maxValue = 0;
+    }
+
+    unsigned long long getCount() {
+        return count;
+    }
+
+    unsigned long long getMax() {
+        return maxValue;
+    }
+
+    // Average of all measurements
+    double getMean() {
+        return count == 0 ? 0.0 : (double)total / count;
+    }
+};
+
+#endif
@@ -0,0 +1,171 @@
+// Load Generator: Simulates many players against the game server
+// Linux only (epoll), connects to the server on loopback TCP
+//
+// Build:  g++ -O2 -std=c++11 LoadGen.cpp -o emoshift-loadgen
+// Run:    ./emoshift-loadgen [players] [seconds] [port] [gridSize]
+//
+// Every player starts a puzzle, then sends random MOVE commands one at a time
+// and waits for each reply. Reports moves/sec and round-trip p50/p99.
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <chrono>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+#define MAX_EVENTS 1024
+
+// State of one simulated player
+struct Player {
+    int fd;
+    string input;
+    bool started;                                   // NEW reply received
+    chrono::steady_clock::time_point sentAt;        // When the pending command was sent
+};
+
+const char* moveCommands[] = {"MOVE U\n", "MOVE D\n", "MOVE L\n", "MOVE R\n"};
+
+// Send one full command (commands are tiny, so a short write means failure)
+bool sendCommand(Player& player, const string& command) {
+    player.sentAt = chrono::steady_clock::now();
+    return send(player.fd, command.data(), command.length(), MSG_NOSIGNAL) == (ssize_t)command.length();
+}
+
+// Open a blocking connection, send one command and return the reply line
+string queryServer(int port, const string& command) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    string reply = "";
+    if (connect(fd, (sockaddr*)&address, sizeof(address)) == 0) {
+        send(fd, command.data(), command.length(), MSG_NOSIGNAL);
+        char c;
+        while (recv(fd, &c, 1, 0) == 1 && c != '\n') reply += c;
+    }
+    close(fd);
+    return reply;
+}
+
+int main(int argc, char* argv[]) {
+    int playerCount = argc > 1 ? atoi(argv[1]) : 10000;
+    int seconds = argc > 2 ? atoi(argv[2]) : 10;
+    int port = argc > 3 ? atoi(argv[3]) : 7777;
+    int gridSize = argc > 4 ? atoi(argv[4]) : 4;
+
+    srand(time(0));
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int epollFd = epoll_create1(0);
+    Player* players = new Player[playerCount];
+    string newCommand = "NEW " + to_string(gridSize) + "\n";
+    int yes = 1;
+    int connected = 0;
+
+    // Connect every player and start a puzzle
+    for (int i = 0; i < playerCount; i++) {
+        players[i].fd = socket(AF_INET, SOCK_STREAM, 0);
+        players[i].started = false;
+        if (players[i].fd < 0 || connect(players[i].fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            cerr << "Connected " << i << " players, then: " << strerror(errno) << "\n";
+            if (players[i].fd >= 0) close(players[i].fd);
+            break;
+        }
+        setsockopt(players[i].fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        fcntl(players[i].fd, F_SETFL, fcntl(players[i].fd, F_GETFL, 0) | O_NONBLOCK);
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, players[i].fd, &event);
+
+        sendCommand(players[i], newCommand);
+        connected++;
+    }
+    cout << "Players connected: " << connected << "\n";
+
+    LatencyHistogram roundTrip;
+    unsigned long long replies = 0;
+    unsigned long long errors = 0;
+    chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+    chrono::steady_clock::time_point endTime = startTime + chrono::seconds(seconds);
+
+    epoll_event events[MAX_EVENTS];
+    while (chrono::steady_clock::now() < endTime) {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+
+        for (int e = 0; e < ready; e++) {
+            Player& player = players[events[e].data.u32];
+            char buffer[1024];
+            ssize_t received;
+            while ((received = recv(player.fd, buffer, sizeof(buffer), 0)) > 0) {
+                player.input.append(buffer, received);
+            }
+
+            size_t end;
+            while ((end = player.input.find('\n')) != string::npos) {
+                chrono::steady_clock::time_point now = chrono::steady_clock::now();
+                string line = player.input.substr(0, end);
+                player.input.erase(0, end + 1);
+
+                if (!player.started) {
+                    player.started = true;
+                    sendCommand(player, moveCommands[rand() % 4]);
+                    continue;
+                }
+
+                roundTrip.record(chrono::duration_cast<chrono::nanoseconds>(now - player.sentAt).count());
+                replies++;
+                if (line.compare(0, 2, "OK") != 0) errors++;
+
+                // Start over once solved ("OK <moves> 1"), otherwise keep moving
+                if (line.compare(0, 2, "OK") == 0 && line[line.length() - 1] == '1') {
+                    sendCommand(player, newCommand);
+                    player.started = false;
+                } else {
+                    sendCommand(player, moveCommands[rand() % 4]);
+                }
+            }
+        }
+    }
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+    cout << "Commands answered: " << replies << " (" << errors << " blocked moves)\n";
+    cout << "Throughput: " << (unsigned long long)(replies / elapsed) << " moves/sec\n";
+    cout << "Round trip p50: " << roundTrip.percentile(0.50) / 1000.0 << " us\n";
+    cout << "Round trip p99: " << roundTrip.percentile(0.99) / 1000.0 << " us\n";
+    cout << "Round trip max: " << roundTrip.getMax() / 1000.0 << " us\n";
+    cout << "Server: " << queryServer(port, "STATS\n") << "\n";
+
+    for (int i = 0; i < connected; i++) close(players[i].fd);
+    delete[] players;
+    close(epollFd);
+    return 0;
+}
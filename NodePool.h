@@ -0,0 +1,91 @@
+// Node Pool: Slab allocator shared by the list, stack and tree nodes
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+// Hands out nodes from slabs of SlabSize nodes instead of one new/delete per node
+// - Nodes come out of a slab in order, so a list built in one go is contiguous
+// - release() puts a single node on a free list for reuse (a stack of node pointers
+//   with room for every node, so releasing never allocates)
+// - reset() makes every node available again in O(1), keeping the slabs
+// - releaseAll() frees the slabs (for containers that will sit empty for a while)
+// Nodes are constructed once when their slab is created and destroyed with the pool,
+// so a reused node still holds its old field values (callers set every field)
+template <typename T, int SlabSize>
+class NodePool {
+    struct Slab {
+        T nodes[SlabSize];
+        Slab* next;
+    };
+
+    Slab* firstSlab;
+    Slab* currentSlab;      // Slab that bump allocation is taking nodes from
+    int used;               // Nodes taken from currentSlab
+    int slabCount;
+    vector<T*> freeNodes;   // Released nodes, reused first (capacity: every node of every slab)
+
+public:
+    NodePool() : firstSlab(NULL), currentSlab(NULL), used(SlabSize), slabCount(0) {}
+
+    ~NodePool() {
+        releaseAll();
+    }
+
+    // Slabs belong to one pool (a copy would free them twice)
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // Get a node (reused if possible, otherwise the next one in the current slab)
+    T* allocate() {
+        if (!freeNodes.empty()) {
+            T* node = freeNodes.back();
+            freeNodes.pop_back();
+            return node;
+        }
+
+        if (used == SlabSize) {
+            // Move on to the next slab, keeping slabs from before a reset()
+            Slab* next = currentSlab == NULL ? firstSlab : currentSlab -> next;
+            if (next == NULL) {
+                next = new Slab();
+                next -> next = NULL;
+                if (currentSlab == NULL) firstSlab = next;
+                else currentSlab -> next = next;
+                size_t nodes = (size_t)++slabCount * SlabSize;
+                if (freeNodes.capacity() < nodes) freeNodes.reserve(nodes > 2 * freeNodes.capacity() ? nodes : 2 * freeNodes.capacity());
+            }
+            currentSlab = next;
+            used = 0;
+        }
+        return &currentSlab -> nodes[used++];
+    }
+
+    // Give one node back to the pool
+    void release(T* node) {
+        freeNodes.push_back(node);
+    }
+
+    // Make every node available again (slabs are kept for reuse)
+    void reset() {
+        currentSlab = NULL;
+        used = SlabSize;
+        freeNodes.clear();
+    }
+
+    // Free every slab (all nodes become invalid, the pool starts out empty again)
+    void releaseAll() {
+        while (firstSlab != NULL) {
+            Slab* temp = firstSlab;
+            firstSlab = firstSlab -> next;
+            delete temp;
+        }
+        slabCount = 0;
+        reset();
+        vector<T*>().swap(freeNodes);
+    }
+};
+
+#endif
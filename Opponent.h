@@ -0,0 +1,129 @@
+// Opponent: Computer player for race mode, running on its own thread
+#ifndef OPPONENT_H
+#define OPPONENT_H
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include "Solver.h"
+#include "InputQueue.h"
+using namespace std;
+
+#define OPPONENT_GREEDY 0       // Lowers the Manhattan distance, no look-ahead
+#define OPPONENT_WEIGHTED 1     // Weighted search: quick, near-optimal plans
+#define OPPONENT_OPTIMAL 2      // Optimal plans (falls back to greedy when out of time)
+
+#define OPPONENT_WEIGHT 3       // Weight of the weighted search
+#define OPPONENT_BUDGET_MS 50   // Search time per move
+
+// Puzzle both racers play; set up before the race and never changed during it
+struct RacePuzzle {
+    BoardTarget target;
+    unsigned char start[MAX_CELLS];
+};
+
+// Computer player
+// The worker thread plays its own copy of the board and sends each move
+// (as a move code) to the game loop through a lock-free queue
+class Opponent {
+    thread worker;
+    const RacePuzzle& puzzle;
+    SpscQueue<unsigned char, KEY_QUEUE_SIZE> moves;
+    atomic<bool> stopping;
+    int strength;
+    int moveDelay;                  // Milliseconds between moves (sets the speed)
+    unsigned int rng;
+
+    // Wait between moves, waking up early if the race is over
+    void rest(chrono::steady_clock::time_point until) {
+        while (!stopping.load() && chrono::steady_clock::now() < until) Sleep(INPUT_IDLE_MS);
+    }
+
+    // Move that lowers the Manhattan distance most (1 in 8 moves random to get unstuck)
+    int greedyMove(const unsigned char* board, int blank, int lastMove) {
+        const BoardTarget& target = puzzle.target;
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        bool random = rng % 8 == 0;
+
+        int best = -1, bestChange = 0;
+        for (int k = 0; k < 4; k++) {
+            int code = (rng + k) & 3;
+            if (code == (lastMove ^ 1)) continue;
+            int next = blankAfterMove(blank, code, target.gridSize);
+            if (next < 0) continue;
+            if (random) return code;
+
+            int change = manhattanChange(target, board[next], next, blank);
+            if (best < 0 || change < bestChange) {
+                best = code;
+                bestChange = change;
+            }
+        }
+        return best;
+    }
+
+    void run() {
+        const BoardTarget& target = puzzle.target;
+        unsigned char board[MAX_CELLS];
+        memcpy(board, puzzle.start, target.cells);
+        int blank = 0;
+        while (board[blank] != 0) blank++;
+
+        unsigned char plan[SOLVE_MAX_LENGTH];
+        int planLength = 0, planStep = 0;
+        int lastMove = 4;
+        int misplaced, distance;
+        evaluateBoard(target, board, misplaced, distance);
+
+        while (!stopping.load() && distance > 0) {
+            chrono::steady_clock::time_point nextMove = chrono::steady_clock::now() + chrono::milliseconds(moveDelay);
+
+            // Plan ahead within the time budget; if the search runs out of time
+            // make one greedy move and try again from the new position
+            if (planStep == planLength && strength != OPPONENT_GREEDY) {
+                int weight = strength == OPPONENT_WEIGHTED ? OPPONENT_WEIGHT : 1;
+                planLength = solveBoardWithin(target, board, weight, OPPONENT_BUDGET_MS, plan);
+                if (planLength == SOLVE_GAVE_UP) planLength = 0;
+                planStep = 0;
+            }
+            int code = planStep < planLength ? plan[planStep++] : greedyMove(board, blank, lastMove);
+
+            int next = blankAfterMove(blank, code, target.gridSize);
+            distance += manhattanChange(target, board[next], next, blank);
+            board[blank] = board[next];
+            board[next] = 0;
+            blank = next;
+            lastMove = code;
+
+            rest(nextMove);
+            while (!moves.push(code) && !stopping.load()) Sleep(INPUT_IDLE_MS);
+        }
+    }
+
+public:
+    // strength: OPPONENT_GREEDY / OPPONENT_WEIGHTED / OPPONENT_OPTIMAL
+    // movesPerSecond: how fast the opponent plays
+    Opponent(const RacePuzzle& puzzle, int strength, int movesPerSecond, unsigned int seed)
+        : puzzle(puzzle), stopping(false), strength(strength),
+          moveDelay(1000 / movesPerSecond), rng(seed != 0 ? seed : 1) {
+        worker = thread(&Opponent::run, this);
+    }
+
+    ~Opponent() {
+        stopping = true;
+        worker.join();
+    }
+
+    // Take the opponent's next move if it has made one (never waits)
+    bool nextMove(int& code) {
+        unsigned char move;
+        if (!moves.pop(move)) return false;
+        code = move;
+        return true;
+    }
+};
+
+#endif
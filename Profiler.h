@@ -0,0 +1,115 @@
+// Profiler: Scoped timers that feed per-thread latency histograms
+// Compiled in only with -DEMOSHIFT_PROFILE, otherwise every call is an empty inline
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <string>
+#include <fstream>
+#include <iomanip>
+using namespace std;
+
+// Timed sections of the game
+enum ProfileProbe {
+    PROBE_INPUT,            // Key read until a frame showing it is drawn
+    PROBE_MOVE,             // makeMove / undoMove
+    PROBE_WIN_CHECK,        // isSolved
+    PROBE_RENDER,           // displayGrid
+    PROBE_SAVE,             // Autosave snapshot write
+    PROBE_LEADERBOARD_IO,   // Leaderboard load / save
+    PROBE_SCREEN_PAUSE,     // Timed messages on the win screen
+    NUM_PROBES
+};
+
+const char* probeNames[NUM_PROBES] = {
+    "input-to-render", "move", "win-check", "render", "autosave", "leaderboard-io", "screen-pause"
+};
+
+#ifdef EMOSHIFT_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include "LatencyHistogram.h"
+
+typedef chrono::steady_clock::time_point ProfileTime;
+
+// Histograms of one thread, only ever written by that thread
+// All threads' profiles form a lock-free list that dumpProfile() walks
+struct ThreadProfile {
+    LatencyHistogram histograms[NUM_PROBES];
+    ThreadProfile* next;
+};
+
+atomic<ThreadProfile*> allProfiles(NULL);
+
+// Get (and on first use register) the calling thread's histograms
+ThreadProfile& threadProfile() {
+    thread_local ThreadProfile* profile = NULL;
+    if (profile == NULL) {
+        profile = new ThreadProfile();     // Lives until the program exits
+        profile -> next = allProfiles.load();
+        while (!allProfiles.compare_exchange_weak(profile -> next, profile)) {}
+    }
+    return *profile;
+}
+
+inline ProfileTime profileNow() {
+    return chrono::steady_clock::now();
+}
+
+// Record the time since start for a probe
+inline void profileRecord(ProfileProbe probe, ProfileTime start) {
+    unsigned long long ns = chrono::duration_cast<chrono::nanoseconds>(profileNow() - start).count();
+    threadProfile().histograms[probe].record(ns);
+}
+
+// Write p50/p99/max of every probe (all threads merged) to a file
+// Other threads keep recording meanwhile, so the newest samples may be missing
+void dumpProfile(string filename) {
+    LatencyHistogram merged[NUM_PROBES];
+    for (ThreadProfile* p = allProfiles.load(); p != NULL; p = p -> next) {
+        for (int i = 0; i < NUM_PROBES; i++) {
+            merged[i].merge(p -> histograms[i]);
+        }
+    }
+
+    ofstream file(filename.c_str());
+    file << left << setw(18) << "probe" << right << setw(10) << "count"
+         << setw(12) << "p50 us" << setw(12) << "p99 us" << setw(12) << "max us" << "\n";
+    for (int i = 0; i < NUM_PROBES; i++) {
+        file << left << setw(18) << probeNames[i] << right << setw(10) << merged[i].getCount()
+             << fixed << setprecision(1)
+             << setw(12) << merged[i].percentile(0.50) / 1000.0
+             << setw(12) << merged[i].percentile(0.99) / 1000.0
+             << setw(12) << merged[i].getMax() / 1000.0 << "\n";
+    }
+}
+
+#else
+
+// Profiling disabled: nothing is measured or stored
+struct ProfileTime {};
+
+inline ProfileTime profileNow() {
+    return ProfileTime();
+}
+
+inline void profileRecord(ProfileProbe, ProfileTime) {}
+
+inline void dumpProfile(string) {}
+
+#endif
+
+// Time the enclosing block
+class ScopedTimer {
+    ProfileProbe probe;
+    ProfileTime start;
+
+public:
+    ScopedTimer(ProfileProbe probe) : probe(probe), start(profileNow()) {}
+
+    ~ScopedTimer() {
+        profileRecord(probe, start);
+    }
+};
+
+#endif
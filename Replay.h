@@ -0,0 +1,71 @@
+// Replay: Won games saved for offline analysis (see ReplayStats.cpp)
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <string>
+#include <fstream>
+#include "GameSession.h"
+#include "Snapshot.h"
+#include "EventLog.h"
+using namespace std;
+
+#define REPLAY_FILE "replays.dat"
+#define REPLAY_VERSION 1
+#define REPLAY_HEADER 8             // Bytes before the first record
+#define REPLAY_NAME_MAX 255
+#define REPLAY_MAX_BYTES (4 << 20)  // Start a new file after 4 MB
+#define REPLAY_KEEP 3               // Old files kept (replays.dat.1 is the newest)
+
+// File layout (little endian):
+//   header   "EMRP", version, 3 zero bytes
+//   records, one per won game:
+//     [0..3]   record length L (bytes after this field)
+//     [4]      player name length n (0 if the score was not saved)
+//     n bytes  player name (as saved to leaderboard.txt)
+//     L-1-n    snapshot of the won game (see Snapshot.h), with the full move history
+// The seed rebuilds the target and undoing the history gives the starting board,
+// so a 4x4 game won in 60 moves takes 51 bytes plus the name
+// Files from many players can be collected in one directory and read together
+//
+// Like the event log, a file that would grow past REPLAY_MAX_BYTES is rotated
+// (replays.dat -> replays.dat.1 -> ... -> replays.dat.REPLAY_KEEP, the oldest dropped),
+// so the game keeps at most (REPLAY_KEEP + 1) x 4 MB of replays: about 280000
+// 4x4 games won in 60 moves
+
+// Append a won game to a replay file (creates the file if needed)
+// The file is rotated first if the record would take it past maxBytes (0 = no limit)
+bool appendReplay(string filename, string playerName, GameSession& game, long long maxBytes = REPLAY_MAX_BYTES) {
+    if (playerName.length() > REPLAY_NAME_MAX) playerName = playerName.substr(0, REPLAY_NAME_MAX);
+    string snapshot = saveSnapshot(game);
+
+    string record;
+    putBytes(record, 1 + playerName.length() + snapshot.length(), 4);
+    putBytes(record, playerName.length(), 1);
+    record += playerName;
+    record += snapshot;
+
+    ofstream file(filename.c_str(), ios::binary | ios::app);
+    if (!file.is_open()) return false;
+    file.seekp(0, ios::end);
+    long long size = file.tellp();
+    if (maxBytes > 0 && size > REPLAY_HEADER && size + (long long)record.length() > maxBytes) {
+        file.close();
+        rotateLogFiles(filename, REPLAY_KEEP);
+        file.open(filename.c_str(), ios::binary | ios::app);
+        if (!file.is_open()) return false;
+        size = 0;
+    }
+    if (size <= 0) {
+        const char header[REPLAY_HEADER] = {'E', 'M', 'R', 'P', REPLAY_VERSION, 0, 0, 0};
+        file.write(header, REPLAY_HEADER);
+    }
+    file.write(record.data(), record.length());
+    return file.good();
+}
+
+// Check a file header (data points at REPLAY_HEADER bytes)
+bool isReplayHeader(const unsigned char* data) {
+    return data[0] == 'E' && data[1] == 'M' && data[2] == 'R' && data[3] == 'P' && data[4] == REPLAY_VERSION;
+}
+
+#endif
@@ -0,0 +1,614 @@
+// Replay Stats: How far won games are from optimal, over a whole corpus of replays
+// Linux only (mmap)
+//
+// Build:  g++ -O2 -std=c++11 -pthread ReplayStats.cpp -o emoshift-replays
+// Run:    emoshift-replays [--threads T] [--node-budget N] [--leaderboard file] <dir>
+//         emoshift-replays --generate <dir> [--files F] [--replays N] [--dealt]
+//
+// Reads every replay file (see Replay.h) in dir, rotated ones too. Each replay
+// is re-simulated: its seed must rebuild the final board and undoing its moves
+// must stay on the grid, which gives the starting board. The optimal length of
+// that board comes from IDA* (Solver.h), cached by seed so a puzzle played many
+// times is solved once.
+// Prints the gap (player moves - optimal moves) per grid size, theme and player.
+// Players are the names stored in the replays; a "*" marks names that also hold
+// one of the scores kept in the leaderboard file (the best LEADERBOARD_KEEP per
+// difficulty, so most players of a large corpus are not marked).
+//
+// Work stealing: every worker has its own task deque. A file task maps the file
+// and pushes one task per REPLAY_CHUNK replays; a worker takes its newest task,
+// and when its deque is empty it steals the oldest task of another worker.
+// A worker that finds nothing to take or steal sleeps until tasks are added.
+//
+// --generate writes a synthetic corpus to try this on: seeds come from a small
+// pool per grid size, each scrambled by a short random walk (so IDA* finishes),
+// and solved by walking back with random detours. Most replays then hit the
+// solve cache, so this measures the replay pipeline more than the solver.
+// With --dealt every game is dealt by startRound() like in the game (a fresh seed
+// and a full shuffle) and solved tile by tile (AnytimeSolver::construct()); this
+// is the realistic load, where nearly every 5x5 board and some 4x4 boards exhaust
+// the node budget.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "GameSession.h"
+#include "Snapshot.h"
+#include "Replay.h"
+#include "Solver.h"
+#include "AnytimeSolver.h"
+#include "BST.h"
+
+using namespace std;
+
+#define REPLAY_CHUNK 256        // Replays per stealable task
+#define CACHE_SHARDS 64         // Independently locked parts of the solve cache
+#define SEED_POOL 500           // Puzzles per grid size in a generated corpus
+
+// Gap totals of one group of replays
+struct GapStats {
+    long long replays;
+    long long solved;           // Optimal length known
+    long long gaveUp;           // Solver ran out of nodes
+    long long perfect;          // Played optimally
+    long long moves;            // Player moves (solved replays only)
+    long long optimal;
+
+    GapStats() : replays(0), solved(0), gaveUp(0), perfect(0), moves(0), optimal(0) {}
+
+    void add(int playerMoves, int optimalMoves) {
+        replays++;
+        if (optimalMoves == SOLVE_GAVE_UP) {
+            gaveUp++;
+            return;
+        }
+        solved++;
+        moves += playerMoves;
+        optimal += optimalMoves;
+        if (playerMoves == optimalMoves) perfect++;
+    }
+
+    void merge(const GapStats& other) {
+        replays += other.replays;
+        solved += other.solved;
+        gaveUp += other.gaveUp;
+        perfect += other.perfect;
+        moves += other.moves;
+        optimal += other.optimal;
+    }
+};
+
+// Results of one worker (merged at the end, so workers never share counters)
+struct WorkerStats {
+    GapStats bySize[MAX_GRID_SIZE + 1];
+    GapStats byTheme[NUM_THEMES + 1];
+    unordered_map<string, GapStats> byPlayer;
+    long long invalid;          // Broken record, wrong target or illegal move
+    long long incomplete;       // History does not reach back to the start
+    long long cacheHits;
+    long long solves;
+    double solveSeconds;
+
+    WorkerStats() : invalid(0), incomplete(0), cacheHits(0), solves(0), solveSeconds(0) {}
+};
+
+// A replay file mapped into memory, unmapped by whoever finishes its last chunk
+struct MappedFile {
+    const unsigned char* data;
+    size_t size;
+    atomic<int> pending;        // Chunks not finished yet
+};
+
+// Unit of work: a whole file (mapped == NULL) or a range of its records
+struct Task {
+    int file;
+    MappedFile* mapped;
+    size_t begin, end;          // Byte range of whole records
+};
+
+// Task deque of one worker (the owner uses the back, thieves the front)
+struct WorkQueue {
+    mutex lock;
+    deque<Task> tasks;
+};
+
+// Optimal length of a seed's starting board
+struct CacheEntry {
+    unsigned long long startHash;   // Retries of a seed start from other boards
+    int length;
+};
+
+struct CacheShard {
+    mutex lock;
+    unordered_map<unsigned long long, CacheEntry> entries;
+};
+
+vector<string> files;
+vector<WorkQueue*> queues;
+atomic<long long> tasksLeft(0);     // Tasks not finished yet
+atomic<long long> tasksQueued(0);   // Tasks in a deque, not taken yet
+mutex idleLock;                     // Only guards the wakeup of idle workers
+condition_variable workAdded;
+CacheShard cache[CACHE_SHARDS];
+long long nodeBudget = 20000000;
+
+// Little endian value from raw bytes
+unsigned int readBytes(const unsigned char* data, int bytes) {
+    unsigned int value = 0;
+    for (int i = 0; i < bytes; i++) value |= (unsigned int)data[i] << (8 * i);
+    return value;
+}
+
+// FNV-1a hash of a packed board
+unsigned long long boardHash(const unsigned char* board, int cells) {
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    for (int c = 0; c < cells; c++) {
+        hash = (hash ^ board[c]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Optimal moves for a starting board (SOLVE_GAVE_UP if over the node budget)
+int optimalLength(unsigned int seed, int gridSize, const unsigned char* targetTiles,
+                  const unsigned char* start, WorkerStats& stats) {
+    int cells = gridSize * gridSize;
+    unsigned long long key = (unsigned long long)seed << 8 | gridSize;
+    unsigned long long startHash = boardHash(start, cells);
+    CacheShard& shard = cache[(seed ^ gridSize) % CACHE_SHARDS];
+    {
+        lock_guard<mutex> lock(shard.lock);
+        unordered_map<unsigned long long, CacheEntry>::iterator it = shard.entries.find(key);
+        if (it != shard.entries.end() && it -> second.startHash == startHash) {
+            stats.cacheHits++;
+            return it -> second.length;
+        }
+    }
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    BoardTarget target;
+    setTarget(target, targetTiles, gridSize);
+    int length = solveBoard(target, start, nodeBudget, NULL);
+    stats.solveSeconds += chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    stats.solves++;
+
+    CacheEntry entry;
+    entry.startHash = startHash;
+    entry.length = length;
+    lock_guard<mutex> lock(shard.lock);
+    shard.entries[key] = entry;
+    return length;
+}
+
+// Re-simulate one replay record and add its gap to the stats
+void analyzeReplay(const unsigned char* record, size_t length, WorkerStats& stats) {
+    if (length < 1 || 1 + (size_t)record[0] > length) {
+        stats.invalid++;
+        return;
+    }
+    int nameLength = record[0];
+    const unsigned char* snapshot = record + 1 + nameLength;
+    size_t snapshotLength = length - 1 - nameLength;
+    if (snapshotLength < SNAPSHOT_HEADER || snapshot[0] != SNAPSHOT_VERSION) {
+        stats.invalid++;
+        return;
+    }
+
+    unsigned int seed = readBytes(snapshot + 1, 4);
+    int theme = snapshot[5];
+    int gridSize = snapshot[6];
+    int blank = snapshot[7];
+    int moves = readBytes(snapshot + 8, 4);
+    int historyLength = readBytes(snapshot + 12, 3);
+    int cells = gridSize * gridSize;
+    if (gridSize < MIN_GRID_SIZE || gridSize > MAX_GRID_SIZE || theme > NUM_THEMES ||
+        snapshotLength != (size_t)(SNAPSHOT_HEADER + cells + (historyLength + 3) / 4) || blank >= cells) {
+        stats.invalid++;
+        return;
+    }
+    if (historyLength != moves) {
+        stats.incomplete++;
+        return;
+    }
+
+    // The seed rebuilds the target, which a won game must end on
+    GameSession pattern;
+    pattern.gridSize = gridSize;
+    pattern.seed = seed;
+    int selected[MAX_CELLS];
+    patternTiles(pattern, selected);
+    unsigned char targetTiles[MAX_CELLS], board[MAX_CELLS];
+    for (int c = 0; c < cells; c++) {
+        targetTiles[c] = selected[c];
+        board[c] = snapshot[SNAPSHOT_HEADER + c];
+    }
+    if (pattern.currentTheme != theme || memcmp(board, targetTiles, cells) != 0 || board[blank] != 0) {
+        stats.invalid++;
+        return;
+    }
+
+    // Undo the moves, newest first, to get back to the starting board
+    const unsigned char* history = snapshot + SNAPSHOT_HEADER + cells;
+    for (int i = historyLength - 1; i >= 0; i--) {
+        int code = (history[i / 4] >> (2 * (i % 4))) & 3;
+        int previous = blankAfterMove(blank, code ^ 1, gridSize);
+        if (previous < 0) {
+            stats.invalid++;
+            return;
+        }
+        board[blank] = board[previous];
+        board[previous] = 0;
+        blank = previous;
+    }
+
+    int optimal = optimalLength(seed, gridSize, targetTiles, board, stats);
+    string name((const char*)record + 1, nameLength);
+    if (name.empty()) name = "(no name)";
+
+    stats.bySize[gridSize].add(moves, optimal);
+    stats.byTheme[theme].add(moves, optimal);
+    stats.byPlayer[name].add(moves, optimal);
+}
+
+// Wake idle workers after tasks were added or the last task finished
+void wakeWorkers() {
+    {
+        lock_guard<mutex> lock(idleLock);
+    }
+    workAdded.notify_all();
+}
+
+// Map a file and push one task per REPLAY_CHUNK records onto the worker's deque
+void splitFile(int worker, int fileIndex) {
+    int fd = open(files[fileIndex].c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < REPLAY_HEADER) {
+        close(fd);
+        return;
+    }
+    void* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return;
+    madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+    MappedFile* mapped = new MappedFile();
+    mapped -> data = (const unsigned char*)data;
+    mapped -> size = info.st_size;
+    if (!isReplayHeader(mapped -> data)) {
+        munmap(data, info.st_size);
+        delete mapped;
+        return;
+    }
+
+    // Find record boundaries (a truncated last record is left out)
+    vector<Task> chunks;
+    size_t pos = REPLAY_HEADER, chunkStart = pos;
+    int records = 0;
+    while (pos + 4 <= mapped -> size) {
+        size_t next = pos + 4 + readBytes(mapped -> data + pos, 4);
+        if (next > mapped -> size) break;
+        pos = next;
+        if (++records % REPLAY_CHUNK == 0) {
+            Task chunk = {fileIndex, mapped, chunkStart, pos};
+            chunks.push_back(chunk);
+            chunkStart = pos;
+        }
+    }
+    if (pos > chunkStart) {
+        Task chunk = {fileIndex, mapped, chunkStart, pos};
+        chunks.push_back(chunk);
+    }
+    if (chunks.empty()) {
+        munmap(data, info.st_size);
+        delete mapped;
+        return;
+    }
+
+    mapped -> pending = chunks.size();
+    tasksLeft += chunks.size();
+    {
+        lock_guard<mutex> lock(queues[worker] -> lock);
+        for (int i = 0; i < (int)chunks.size(); i++) queues[worker] -> tasks.push_back(chunks[i]);
+    }
+    tasksQueued += chunks.size();
+    wakeWorkers();
+}
+
+// Analyze a range of records, unmapping the file after its last chunk
+void runChunk(const Task& task, WorkerStats& stats) {
+    const unsigned char* data = task.mapped -> data;
+    size_t pos = task.begin;
+    while (pos < task.end) {
+        size_t length = readBytes(data + pos, 4);
+        analyzeReplay(data + pos + 4, length, stats);
+        pos += 4 + length;
+    }
+    if (--task.mapped -> pending == 0) {
+        munmap((void*)task.mapped -> data, task.mapped -> size);
+        delete task.mapped;
+    }
+}
+
+// Take the newest task of this worker, or steal the oldest task of another
+bool nextTask(int worker, Task& task) {
+    {
+        WorkQueue& own = *queues[worker];
+        lock_guard<mutex> lock(own.lock);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            tasksQueued--;
+            return true;
+        }
+    }
+    int count = queues.size();
+    for (int i = 1; i < count; i++) {
+        WorkQueue& victim = *queues[(worker + i) % count];
+        lock_guard<mutex> lock(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            tasksQueued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void runWorker(int worker, WorkerStats* stats) {
+    Task task;
+    while (true) {
+        if (nextTask(worker, task)) {
+            if (task.mapped == NULL) splitFile(worker, task.file);
+            else runChunk(task, *stats);
+            if (--tasksLeft == 0) wakeWorkers();
+            continue;
+        }
+
+        // Nothing to take: sleep until another worker splits a file or the work is done
+        unique_lock<mutex> lock(idleLock);
+        workAdded.wait(lock, [] { return tasksLeft.load() == 0 || tasksQueued.load() > 0; });
+        if (tasksLeft.load() == 0) return;
+    }
+}
+
+// Replay file name: *.dat, or *.dat.N rotated by appendReplay()
+bool isReplayFileName(const string& name) {
+    size_t dot = name.rfind(".dat");
+    if (dot == string::npos || dot == 0) return false;
+    string rest = name.substr(dot + 4);
+    return rest.empty() || (rest.length() > 1 && rest[0] == '.' && rest.find_first_not_of("0123456789", 1) == string::npos);
+}
+
+// Replay files in a directory, sorted by name
+void listFiles(string dir) {
+    DIR* handle = opendir(dir.c_str());
+    if (handle == NULL) return;
+    struct dirent* entry;
+    while ((entry = readdir(handle)) != NULL) {
+        string name = entry -> d_name;
+        if (isReplayFileName(name)) files.push_back(dir + "/" + name);
+    }
+    closedir(handle);
+    sort(files.begin(), files.end());
+}
+
+// Deal a game like the game does and solve it tile by tile
+void playDealtGame(GameSession& game, AnytimeSolver& solver) {
+    startRound(game, true);
+
+    unsigned char targetTiles[MAX_CELLS], board[MAX_CELLS], path[SOLVE_MAX_LENGTH];
+    packBoard(game.targetGrid, game.gridSize, targetTiles);
+    packBoard(game.currentGrid, game.gridSize, board);
+    BoardTarget target;
+    setTarget(target, targetTiles, game.gridSize);
+    solver.start(target, board);
+    solver.construct();
+
+    int length = solver.getSolution(path);
+    for (int i = 0; i < length; i++) makeMove(game, moveKey(path[i]));
+}
+
+// Write a synthetic corpus (see the top of this file)
+// dealt: deal every game with startRound() instead of scrambling pooled seeds a little
+void generateCorpus(string dir, int fileCount, long long replays, bool dealt) {
+    static const char* names[] = {"Bading", "Frances", "Ces", "Pransess", "Maoi", "Kit", "Juno", ""};
+    mkdir(dir.c_str(), 0755);
+    srand(7);
+    AnytimeSolver solver(1);    // Only construct() is used, so the search arena can be tiny
+
+    for (int f = 0; f < fileCount; f++) {
+        string filename = dir + "/replays-" + to_string(f) + ".dat";
+        remove(filename.c_str());
+        long long count = replays / fileCount + (f < replays % fileCount ? 1 : 0);
+        for (long long r = 0; r < count; r++) {
+            GameSession game;
+            int roll = rand() % 10;
+            game.gridSize = roll < 6 ? 3 : roll < 9 ? 4 : 5;
+            if (dealt) {
+                playDealtGame(game, solver);
+                appendReplay(filename, names[rand() % 8], game, 0);
+                clearSession(game);
+                continue;
+            }
+
+            game.seed = game.gridSize * 100000 + rand() % SEED_POOL;
+            buildPattern(game);
+            initializeGrid(game, false);
+
+            // Same seed, same walk: a short scramble from the seed's random numbers
+            // (never straight back, so the walk does not undo itself)
+            int walk = game.gridSize * game.gridSize * 2;
+            int last = -1;
+            for (int i = 0; i < walk; i++) {
+                int code = nextRandom(game) % 4;
+                if (last >= 0 && code == (last ^ 1)) continue;
+                if (makeMove(game, directionFromCode(code))) last = code;
+            }
+            string scramble = game.moveHistory.getDirections();
+            game.moves = 0;
+            game.moveHistory.clear();
+
+            // Walk back, now and then trying a move and taking it back
+            for (int i = (int)scramble.length() - 1; i >= 0; i--) {
+                if (rand() % 4 == 0) {
+                    char detour = directionFromCode(rand() % 4);
+                    if (makeMove(game, detour)) makeMove(game, directionFromCode(directionCode(detour) ^ 1));
+                }
+                makeMove(game, directionFromCode(directionCode(scramble[i]) ^ 1));
+            }
+            appendReplay(filename, names[rand() % 8], game, 0);
+            clearSession(game);
+        }
+    }
+    cout << "Wrote " << replays << (dealt ? " dealt" : "") << " replays to " << fileCount << " files in " << dir << "\n";
+}
+
+// One table row: replays, gave up, mean moves / optimal / gap, optimal play share
+void printRow(string label, GapStats& stats) {
+    cout << "  " << left << setw(16) << label << right << setw(10) << stats.replays << setw(9) << stats.gaveUp;
+    if (stats.solved > 0) {
+        double solved = stats.solved;
+        cout << fixed << setprecision(1) << setw(9) << stats.moves / solved << setw(9) << stats.optimal / solved
+             << setw(9) << (stats.moves - stats.optimal) / solved << setw(10) << 100.0 * stats.perfect / solved << "%";
+    }
+    cout << "\n";
+}
+
+void printHeader(string label) {
+    cout << "\n  " << left << setw(16) << label << right << setw(10) << "replays" << setw(9) << "gave up"
+         << setw(9) << "moves" << setw(9) << "optimal" << setw(9) << "gap" << setw(11) << "perfect" << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    int threads = thread::hardware_concurrency();
+    string dir = "", generateDir = "", leaderboardFile = "leaderboard.txt";
+    int fileCount = 16;
+    long long replays = 100000;
+    bool dealt = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (arg == "--node-budget" && i + 1 < argc) nodeBudget = atoll(argv[++i]);
+        else if (arg == "--leaderboard" && i + 1 < argc) leaderboardFile = argv[++i];
+        else if (arg == "--generate" && i + 1 < argc) generateDir = argv[++i];
+        else if (arg == "--files" && i + 1 < argc) fileCount = atoi(argv[++i]);
+        else if (arg == "--replays" && i + 1 < argc) replays = atoll(argv[++i]);
+        else if (arg == "--dealt") dealt = true;
+        else dir = arg;
+    }
+    if (generateDir != "") {
+        generateCorpus(generateDir, fileCount > 0 ? fileCount : 1, replays, dealt);
+        return 0;
+    }
+    if (dir == "") {
+        cout << "Usage: emoshift-replays [--threads T] [--node-budget N] [--leaderboard file] <dir>\n"
+             << "       emoshift-replays --generate <dir> [--files F] [--replays N] [--dealt]\n";
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+
+    // Names with a score in the leaderboard file (only marks them: replays are
+    // grouped by the name they store, listed or not)
+    BST leaderboard;
+    leaderboard.loadFromFile(leaderboardFile);
+    vector<BSTNode> scores;
+    leaderboard.topScores(leaderboard.getSize(), 0, scores);
+    unordered_set<string> listedPlayers;
+    for (int i = 0; i < (int)scores.size(); i++) listedPlayers.insert(scores[i].name);
+
+    listFiles(dir);
+    if (files.empty()) {
+        cout << "No replay files (*.dat, *.dat.N) in " << dir << "\n";
+        return 1;
+    }
+
+    // Deal the files round robin; chunks get stolen from there
+    for (int t = 0; t < threads; t++) queues.push_back(new WorkQueue());
+    for (int f = 0; f < (int)files.size(); f++) {
+        Task task = {f, NULL, 0, 0};
+        queues[f % threads] -> tasks.push_back(task);
+    }
+    tasksLeft = files.size();
+    tasksQueued = files.size();
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<WorkerStats*> workerStats;
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workerStats.push_back(new WorkerStats());
+        workers.push_back(thread(runWorker, t, workerStats[t]));
+    }
+    for (int t = 0; t < threads; t++) workers[t].join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    WorkerStats total;
+    for (int t = 0; t < threads; t++) {
+        WorkerStats& stats = *workerStats[t];
+        for (int s = 0; s <= MAX_GRID_SIZE; s++) total.bySize[s].merge(stats.bySize[s]);
+        for (int s = 0; s <= NUM_THEMES; s++) total.byTheme[s].merge(stats.byTheme[s]);
+        for (unordered_map<string, GapStats>::iterator it = stats.byPlayer.begin(); it != stats.byPlayer.end(); ++it) {
+            total.byPlayer[it -> first].merge(it -> second);
+        }
+        total.invalid += stats.invalid;
+        total.incomplete += stats.incomplete;
+        total.cacheHits += stats.cacheHits;
+        total.solves += stats.solves;
+        total.solveSeconds += stats.solveSeconds;
+        delete workerStats[t];
+    }
+
+    long long analyzed = 0, gaveUp = 0;
+    for (int s = 0; s <= MAX_GRID_SIZE; s++) {
+        analyzed += total.bySize[s].replays;
+        gaveUp += total.bySize[s].gaveUp;
+    }
+    long long lookups = total.cacheHits + total.solves;
+    cout << analyzed << " replays from " << files.size() << " files on " << threads << " threads in "
+         << fixed << setprecision(2) << seconds << " s: " << setprecision(0) << analyzed / seconds << " replays/s\n";
+    cout << "Skipped " << total.invalid << " invalid and " << total.incomplete << " incomplete replays\n";
+    cout << "Solver: " << total.solves << " solves (" << setprecision(1) << total.solveSeconds << " s of thread time), "
+         << total.cacheHits << " cache hits (" << (lookups > 0 ? 100.0 * total.cacheHits / lookups : 0.0) << "%), "
+         << "gave up on " << gaveUp << " replays (" << (analyzed > 0 ? 100.0 * gaveUp / analyzed : 0.0) << "%)\n";
+
+    printHeader("grid");
+    for (int s = 0; s <= MAX_GRID_SIZE; s++) {
+        if (total.bySize[s].replays > 0) printRow(to_string(s) + "x" + to_string(s), total.bySize[s]);
+    }
+    printHeader("theme");
+    for (int s = 0; s <= NUM_THEMES; s++) {
+        if (total.byTheme[s].replays > 0) printRow(themes[s], total.byTheme[s]);
+    }
+
+    // Players with the most replays first
+    vector<pair<long long, string> > players;
+    for (unordered_map<string, GapStats>::iterator it = total.byPlayer.begin(); it != total.byPlayer.end(); ++it) {
+        players.push_back(make_pair(-it -> second.replays, it -> first));
+    }
+    sort(players.begin(), players.end());
+    printHeader("player");
+    for (int i = 0; i < (int)players.size(); i++) {
+        string name = players[i].second;
+        printRow(listedPlayers.count(name) > 0 ? name + " *" : name, total.byPlayer[name]);
+    }
+    if (!listedPlayers.empty()) cout << "  (* = also has a score in " << leaderboardFile << ")\n";
+    return 0;
+}
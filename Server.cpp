@@ -0,0 +1,401 @@
+// Game Server: Hosts many concurrent puzzle sessions from one process
+// Linux only (epoll), listens on loopback TCP
+//
+// Build:  g++ -O2 -std=c++11 Server.cpp -o emoshift-server
+// Run:    ./emoshift-server [port] [maxSessions] [idleSeconds]
+//
+// Sessions idle for idleSeconds (default 300, 0 = never) are saved as
+// snapshots under sessions/ and their memory is freed. The next command
+// from that player loads the snapshot back.
+//
+// Protocol (one command per line, one reply per line):
+//   NEW <size>       -> OK <theme> <size>        start a new shuffled puzzle
+//   MOVE <U|D|L|R>   -> OK <moves> <solved>      arrow key direction
+//   UNDO             -> OK <moves>
+//   RETRY            -> OK                       restart the same puzzle
+//   BOARD            -> OK <tile> <tile> ...     current tiles, row by row (0 = empty)
+//   STATS            -> OK sessions=<n> moves=<n> blocked=<n> lost=<n> p50=<ns> p99=<ns> max=<ns>
+//                       (latency of moves that were made; blocked moves are only counted;
+//                       lost = parked sessions whose snapshot could not be loaded back)
+//   QUIT             -> closes the connection
+// Errors reply with "ERR <reason>"
+// If a parked session cannot be loaded back, the command that woke it gets
+// "ERR session lost" and the player has no puzzle until NEW
+// A line longer than MAX_LINE closes the connection. A client that does not read
+// its replies is not read from while MAX_OUTPUT bytes of replies are waiting.
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <csignal>
+#include <chrono>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "GameSession.h"
+#include "Snapshot.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+#define MAX_EVENTS 1024
+#define MAX_LINE 256        // Longest accepted command line
+#define MAX_OUTPUT 65536    // Pending reply bytes before the server stops reading a client
+
+// Network state of one connected player (same index as its session)
+struct Connection {
+    int fd;
+    string input;       // Bytes received but not yet processed
+    string output;      // Replies not yet written to the socket
+    time_t lastActive;  // When the last command arrived
+    bool parked;        // Session saved to disk and freed from memory
+    bool lost;          // Unparking failed; the next command is answered "ERR session lost"
+};
+
+volatile sig_atomic_t running = 1;
+LatencyHistogram moveLatency;       // Time spent applying MOVE commands that moved a tile
+unsigned long long blockedMoves = 0;
+unsigned long long lostSessions = 0;    // Parked sessions whose snapshot failed to load
+
+void stopServer(int) {
+    running = 0;
+}
+
+// Make a socket non-blocking
+void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// Map a protocol direction letter to an arrow key code
+char directionKey(char letter) {
+    if (letter == 'U' || letter == 'u') return KEY_UP;
+    if (letter == 'D' || letter == 'd') return KEY_DOWN;
+    if (letter == 'L' || letter == 'l') return KEY_LEFT;
+    if (letter == 'R' || letter == 'r') return KEY_RIGHT;
+    return 0;
+}
+
+// Execute one command line against a session and return the reply
+// Returns an empty string when the connection should be closed
+string handleCommand(SessionPool& pool, GameSession& game, const string& line) {
+    if (line.compare(0, 5, "MOVE ") == 0 && line.length() > 5) {
+        if (game.gridSize == 0) return "ERR no game\n";
+        char key = directionKey(line[5]);
+        if (key == 0) return "ERR bad direction\n";
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        bool moved = makeMove(game, key);
+        if (!moved) {
+            blockedMoves++;     // Only a bounds check, would skew the histogram
+            return "ERR blocked\n";
+        }
+        bool solved = isSolved(game);
+        moveLatency.record(chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now() - start).count());
+
+        return "OK " + to_string(game.moves) + " " + (solved ? "1" : "0") + "\n";
+    }
+
+    if (line.compare(0, 4, "NEW ") == 0) {
+        int size = atoi(line.c_str() + 4);
+        if (size < MIN_GRID_SIZE || size > MAX_GRID_SIZE) return "ERR bad size\n";
+        game.gridSize = size;
+        startRound(game, true);
+        return "OK " + themes[game.currentTheme] + " " + to_string(size) + "\n";
+    }
+
+    if (line == "UNDO") {
+        if (!undoMove(game)) return "ERR nothing to undo\n";
+        return "OK " + to_string(game.moves) + "\n";
+    }
+
+    if (line == "RETRY") {
+        if (game.gridSize == 0) return "ERR no game\n";
+        startRound(game, false);
+        return "OK\n";
+    }
+
+    if (line == "BOARD") {
+        string reply = "OK";
+        for (int i = 0; i < game.gridSize; i++) {
+            for (int j = 0; j < game.gridSize; j++) {
+                reply += " " + to_string(game.currentGrid.getTile(i, j));
+            }
+        }
+        return reply + "\n";
+    }
+
+    if (line == "STATS") {
+        return "OK sessions=" + to_string(pool.getActive()) +
+               " moves=" + to_string(moveLatency.getCount()) +
+               " blocked=" + to_string(blockedMoves) +
+               " lost=" + to_string(lostSessions) +
+               " p50=" + to_string(moveLatency.percentile(0.50)) +
+               " p99=" + to_string(moveLatency.percentile(0.99)) +
+               " max=" + to_string(moveLatency.getMax()) + "\n";
+    }
+
+    if (line == "QUIT") return "";
+    return "ERR unknown command\n";
+}
+
+// Write as much pending output as the socket accepts
+// Returns false if the connection failed
+bool flushOutput(Connection& conn) {
+    while (!conn.output.empty()) {
+        ssize_t sent = send(conn.fd, conn.output.data(), conn.output.length(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        conn.output.erase(0, sent);
+    }
+    return true;
+}
+
+// File that holds the snapshot of a parked session
+string parkedFile(int id) {
+    return "sessions/" + to_string(id) + ".snap";
+}
+
+// Move an idle session out of memory into a snapshot file
+void parkSession(Connection& conn, GameSession& game, int id) {
+    if (saveSnapshotFile(game, parkedFile(id))) {
+        clearSession(game);
+        conn.parked = true;
+    }
+}
+
+// Bring a parked session back into memory
+// A snapshot that does not load (missing, truncated or corrupt) cannot be retried,
+// so the session is dropped and the player is told on their next command
+void unparkSession(Connection& conn, GameSession& game, int id) {
+    if (!loadSnapshotFile(game, parkedFile(id))) {
+        game.gridSize = 0;
+        conn.lost = true;
+        lostSessions++;
+    }
+    remove(parkedFile(id).c_str());
+    conn.parked = false;
+}
+
+// Close a connection and return its session to the pool
+void closeConnection(int epollFd, SessionPool& pool, Connection* connections, int id) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connections[id].fd, NULL);
+    close(connections[id].fd);
+    if (connections[id].parked) remove(parkedFile(id).c_str());
+    connections[id].fd = -1;
+    connections[id].parked = false;
+    connections[id].lost = false;
+    connections[id].input.clear();
+    connections[id].output.clear();
+    pool.release(id);
+}
+
+// Answer every complete line received so far
+// Stops early while MAX_OUTPUT bytes of replies are waiting (the rest is answered once they are sent)
+// Returns false if the connection should be closed
+bool answerLines(SessionPool& pool, Connection& conn, GameSession& game) {
+    size_t start = 0;
+    size_t end;
+    while (conn.output.length() < MAX_OUTPUT && (end = conn.input.find('\n', start)) != string::npos) {
+        string line = conn.input.substr(start, end - start);
+        if (!line.empty() && line[line.length() - 1] == '\r') line.erase(line.length() - 1);
+        start = end + 1;
+
+        string reply;
+        if (conn.lost && line != "QUIT") {
+            conn.lost = false;
+            reply = "ERR session lost\n";
+        } else {
+            reply = handleCommand(pool, game, line);
+        }
+        if (reply.empty()) {
+            flushOutput(conn);
+            return false;
+        }
+        conn.output += reply;
+    }
+    conn.input.erase(0, start);
+
+    // An unfinished line that is already too long is never a command
+    if (conn.input.length() > MAX_LINE && conn.input.find('\n') == string::npos) return false;
+    return true;
+}
+
+// Read available bytes and answer lines as they arrive, so input never holds
+// more than one read past MAX_LINE
+// Returns false if the connection should be closed
+bool serviceConnection(SessionPool& pool, Connection& conn, GameSession& game) {
+    char buffer[4096];
+    while (conn.output.length() < MAX_OUTPUT) {
+        ssize_t received = recv(conn.fd, buffer, sizeof(buffer), 0);
+        if (received == 0) return false;
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        conn.input.append(buffer, received);
+        if (!answerLines(pool, conn, game)) return false;
+    }
+
+    return flushOutput(conn);
+}
+
+int main(int argc, char* argv[]) {
+    int port = argc > 1 ? atoi(argv[1]) : 7777;
+    int maxSessions = argc > 2 ? atoi(argv[2]) : 16384;
+    int idleSeconds = argc > 3 ? atoi(argv[3]) : 300;
+
+    srand(time(0));
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+
+    // Every session needs one file descriptor
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    SessionPool pool(maxSessions);
+    Connection* connections = new Connection[maxSessions];
+    for (int i = 0; i < maxSessions; i++) {
+        connections[i].fd = -1;
+        connections[i].parked = false;
+        connections[i].lost = false;
+        pool.get(i).gridSize = 0;   // No puzzle until NEW
+    }
+    if (idleSeconds > 0) mkdir("sessions", 0755);
+
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int yes = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, 4096) < 0) {
+        cerr << "Cannot listen on port " << port << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+    setNonBlocking(listenFd);
+
+    int epollFd = epoll_create1(0);
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = maxSessions;   // Listening socket uses the id past the last session
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+    cout << "EmoShift server on 127.0.0.1:" << port << " (" << maxSessions << " sessions)\n";
+
+    epoll_event events[MAX_EVENTS];
+    time_t lastParkCheck = time(0);
+    while (running) {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+        if (ready < 0 && errno != EINTR) break;
+        time_t now = time(0);
+
+        // Park sessions that have been idle too long (checked once per second)
+        if (idleSeconds > 0 && now != lastParkCheck) {
+            lastParkCheck = now;
+            for (int i = 0; i < maxSessions; i++) {
+                Connection& conn = connections[i];
+                if (conn.fd >= 0 && !conn.parked && pool.get(i).gridSize != 0 &&
+                    now - conn.lastActive >= idleSeconds) {
+                    parkSession(conn, pool.get(i), i);
+                }
+            }
+        }
+
+        for (int e = 0; e < ready; e++) {
+            int id = (int)events[e].data.u64;
+
+            // New players: give each one a session from the pool
+            if (id == maxSessions) {
+                while (true) {
+                    int fd = accept(listenFd, NULL, NULL);
+                    if (fd < 0) break;
+
+                    int session = pool.acquire();
+                    if (session < 0) {
+                        const char* full = "ERR server full\n";
+                        send(fd, full, strlen(full), MSG_NOSIGNAL);
+                        close(fd);
+                        continue;
+                    }
+
+                    setNonBlocking(fd);
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+                    connections[session].fd = fd;
+                    connections[session].lastActive = now;
+                    pool.get(session).gridSize = 0;
+
+                    epoll_event add;
+                    add.events = EPOLLIN;
+                    add.data.u64 = session;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &add);
+                }
+                continue;
+            }
+
+            Connection& conn = connections[id];
+            bool keep = true;
+
+            if (events[e].events & (EPOLLHUP | EPOLLERR)) {
+                keep = false;
+            } else if (events[e].events & EPOLLIN) {
+                if (conn.parked) unparkSession(conn, pool.get(id), id);
+                conn.lastActive = now;
+                keep = serviceConnection(pool, conn, pool.get(id));
+            } else if (events[e].events & EPOLLOUT) {
+                // Lines held back while the client was not reading get answered now
+                keep = flushOutput(conn);
+                if (keep && !conn.input.empty() && conn.output.length() < MAX_OUTPUT) {
+                    if (conn.parked) unparkSession(conn, pool.get(id), id);
+                    keep = answerLines(pool, conn, pool.get(id)) && flushOutput(conn);
+                }
+            }
+
+            if (!keep) {
+                closeConnection(epollFd, pool, connections, id);
+                continue;
+            }
+
+            // Ask for a write notification only while output is pending,
+            // and stop reading while too much of it is
+            epoll_event mod;
+            if (conn.output.empty()) mod.events = EPOLLIN;
+            else if (conn.output.length() < MAX_OUTPUT) mod.events = EPOLLIN | EPOLLOUT;
+            else mod.events = EPOLLOUT;
+            mod.data.u64 = id;
+            if (!conn.output.empty() || (events[e].events & EPOLLOUT)) {
+                epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.fd, &mod);
+            }
+        }
+    }
+
+    cout << "\nMoves handled: " << moveLatency.getCount() << " (" << blockedMoves << " blocked)\n";
+    cout << "Sessions lost on unpark: " << lostSessions << "\n";
+    cout << "Move latency p50: " << moveLatency.percentile(0.50) << " ns\n";
+    cout << "Move latency p99: " << moveLatency.percentile(0.99) << " ns\n";
+    cout << "Move latency max: " << moveLatency.getMax() << " ns\n";
+
+    for (int i = 0; i < maxSessions; i++) {
+        if (connections[i].fd >= 0) close(connections[i].fd);
+    }
+    delete[] connections;
+    close(epollFd);
+    close(listenFd);
+    return 0;
+}
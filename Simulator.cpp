@@ -0,0 +1,380 @@
+// Simulator: Plays many headless games with simple strategies
+//
+// Build:  g++ -O2 -std=c++11 -pthread Simulator.cpp -o emoshift-sim
+// Run:    emoshift-sim [--games N] [--threads T] [--max-size N] [--max-moves M]
+//                      [--shuffle-factor F] [--hint-games N] [--hint-budget nodes]
+//
+// Games are scrambled like shuffleGrid() (gridSize^2 * F random empty-space moves)
+// and played by each policy until solved or --max-moves is reached:
+//   random  random legal move, never undoing the previous one
+//   greedy  move that lowers the Manhattan distance most (1 in 8 moves random)
+//   hint    plays the optimal solution (IDA*, gives up after --hint-budget nodes;
+//           those games are not played and only counted under "gave up")
+// Prints move-count distributions per grid size, the share of solved games
+// that would get 5 or 4 stars from displayEfficiencyRating() and the median
+// Manhattan distance of the scrambled boards ("start"). The hint distribution
+// only covers the boards IDA* solved, which are the easier ones, so read it
+// together with the "gave up" share.
+// moves/s/core counts only the time spent playing moves (not scrambling or solving).
+// All policies play the same scrambled boards (seeded per thread and batch).
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "Themes.h"
+#include "BoardEval.h"
+#include "Solver.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+#define BATCH_SIZE 1024         // Games stepped together by one thread
+
+enum Policy { POLICY_RANDOM, POLICY_GREEDY, POLICY_HINT, NUM_POLICIES };
+const char* policyNames[NUM_POLICIES] = {"random", "greedy", "hint"};
+
+// Simulation settings shared by all threads
+struct SimConfig {
+    int gridSize;
+    int shuffleFactor;
+    int maxMoves;
+    long long hintBudget;
+    Policy policy;
+};
+
+// Results of one thread (merged after all threads finish)
+struct SimStats {
+    LatencyHistogram moves;         // Moves of solved games
+    LatencyHistogram scramble;      // Manhattan distance right after shuffling
+    long long games;
+    long long solved;
+    long long gaveUp;               // Hint policy: IDA* ran out of nodes, game not played
+    long long fiveStars;
+    long long fourStars;
+    long long movesPlayed;          // All simulated moves, solved or not
+    double playSeconds;             // Time spent playing moves
+    double solveSeconds;            // Time spent in IDA* (hint policy)
+
+    SimStats() : games(0), solved(0), gaveUp(0), fiveStars(0), fourStars(0), movesPlayed(0),
+                 playSeconds(0), solveSeconds(0) {}
+
+    void merge(const SimStats& other) {
+        moves.merge(other.moves);
+        scramble.merge(other.scramble);
+        games += other.games;
+        solved += other.solved;
+        gaveUp += other.gaveUp;
+        fiveStars += other.fiveStars;
+        fourStars += other.fourStars;
+        movesPlayed += other.movesPlayed;
+        playSeconds += other.playSeconds;
+        solveSeconds += other.solveSeconds;
+    }
+};
+
+// A batch of games stored as structure of arrays
+// Game g's board is tiles[g * cells .. g * cells + cells - 1]
+struct GameBatch {
+    int count;
+    int cells;
+    unsigned char* tiles;
+    unsigned char* blank;           // Position of the empty space
+    unsigned char* lastMove;        // Move code of the previous move (4 = none)
+    unsigned int* rng;              // xorshift32 state of each game
+    int* manhattan;
+    int* misplaced;
+    int* moves;
+    unsigned char* done;            // 1 = solved, 2 = not played (hint policy gave up)
+    unsigned char* path;            // Hint policy: game g's solution at path[g * SOLVE_MAX_LENGTH]
+
+    GameBatch(int count, int cells) : count(count), cells(cells) {
+        tiles = new unsigned char[count * cells];
+        blank = new unsigned char[count];
+        lastMove = new unsigned char[count];
+        rng = new unsigned int[count];
+        manhattan = new int[count];
+        misplaced = new int[count];
+        moves = new int[count];
+        done = new unsigned char[count];
+        path = new unsigned char[count * SOLVE_MAX_LENGTH];
+    }
+
+    ~GameBatch() {
+        delete[] tiles;
+        delete[] blank;
+        delete[] lastMove;
+        delete[] rng;
+        delete[] manhattan;
+        delete[] misplaced;
+        delete[] moves;
+        delete[] done;
+        delete[] path;
+    }
+};
+
+inline unsigned int nextRandom(unsigned int& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// Independent seed for each thread and round (splitmix32 finalizer)
+unsigned int streamSeed(unsigned int thread, unsigned int round) {
+    unsigned int x = thread * 0x9E3779B9u + round * 0x85EBCA6Bu + 1;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x != 0 ? x : 1;
+}
+
+// Reset every game of the batch to a freshly shuffled board
+// The target is the layout buildPattern() makes, with tiles renamed so that
+// tile k belongs in cell k-1 (the empty space always ends up in the last cell)
+void scrambleBatch(GameBatch& batch, const SimConfig& config, unsigned int seed) {
+    int gridSize = config.gridSize;
+    int cells = batch.cells;
+    int shuffles = cells * config.shuffleFactor;
+
+    for (int g = 0; g < batch.count; g++) {
+        unsigned char* board = batch.tiles + g * cells;
+        for (int c = 0; c < cells - 1; c++) board[c] = c + 1;
+        board[cells - 1] = 0;
+
+        unsigned int x = seed + g * 0x9E3779B9u;
+        if (x == 0) x = 1;
+
+        // Same as shuffleGrid(): moves into the edge do nothing
+        int blank = cells - 1;
+        for (int i = 0; i < shuffles; i++) {
+            int next = blankAfterMove(blank, nextRandom(x) % 4, gridSize);
+            if (next < 0) continue;
+            board[blank] = board[next];
+            board[next] = 0;
+            blank = next;
+        }
+
+        batch.blank[g] = blank;
+        batch.lastMove[g] = 4;
+        batch.rng[g] = x;
+        batch.moves[g] = 0;
+    }
+}
+
+// Pick the next move of one game (never the undo of its previous move)
+inline int chooseMove(const GameBatch& batch, const BoardTarget& target, int g, Policy policy) {
+    int blank = batch.blank[g];
+    int last = batch.lastMove[g];
+    unsigned int& x = batch.rng[g];
+
+    if (policy == POLICY_HINT) return batch.path[g * SOLVE_MAX_LENGTH + batch.moves[g]];
+    if (policy == POLICY_RANDOM || nextRandom(x) % 8 == 0) {
+        while (true) {
+            int code = nextRandom(x) % 4;
+            if (code != (last ^ 1) && blankAfterMove(blank, code, target.gridSize) >= 0) return code;
+        }
+    }
+
+    // Greedy: smallest Manhattan change, ties broken by a random start
+    const unsigned char* board = batch.tiles + g * batch.cells;
+    int best = -1, bestChange = 0;
+    int start = nextRandom(x) % 4;
+    for (int k = 0; k < 4; k++) {
+        int code = (start + k) & 3;
+        if (code == (last ^ 1)) continue;
+        int next = blankAfterMove(blank, code, target.gridSize);
+        if (next < 0) continue;
+        int change = manhattanChange(target, board[next], next, blank);
+        if (best < 0 || change < bestChange) {
+            best = code;
+            bestChange = change;
+        }
+    }
+    return best;
+}
+
+// Record the result of a finished game
+void finishGame(SimStats& stats, int gridSize, int moves, bool solved) {
+    stats.games++;
+    if (!solved) return;
+    stats.solved++;
+    stats.moves.record(moves);
+    if (moves <= gridSize * gridSize * 3) stats.fiveStars++;
+    else if (moves <= gridSize * gridSize * 5) stats.fourStars++;
+}
+
+// Play games batch by batch: every round advances each unfinished game by one move
+void simulateThread(SimConfig config, long long games, unsigned int threadIndex, SimStats* out) {
+    SimStats& stats = *out;
+    int gridSize = config.gridSize;
+    int cells = gridSize * gridSize;
+
+    unsigned char targetTiles[MAX_CELLS];
+    for (int c = 0; c < cells - 1; c++) targetTiles[c] = c + 1;
+    targetTiles[cells - 1] = 0;
+    BoardTarget target;
+    setTarget(target, targetTiles, gridSize);
+
+    GameBatch batch(BATCH_SIZE, cells);
+
+    for (unsigned int round = 0; games > 0; round++) {
+        batch.count = games < BATCH_SIZE ? (int)games : BATCH_SIZE;
+        games -= batch.count;
+
+        scrambleBatch(batch, config, streamSeed(threadIndex, round));
+        evaluateBoards(target, batch.tiles, batch.count, batch.misplaced, batch.manhattan, batch.done);
+        for (int g = 0; g < batch.count; g++) stats.scramble.record(batch.manhattan[g]);
+
+        // Hint policy: solve every board first, then play the solutions like any other policy
+        if (config.policy == POLICY_HINT) {
+            chrono::steady_clock::time_point solveStart = chrono::steady_clock::now();
+            for (int g = 0; g < batch.count; g++) {
+                if (batch.done[g]) continue;
+                int length = solveBoard(target, batch.tiles + g * cells, config.hintBudget,
+                                        batch.path + g * SOLVE_MAX_LENGTH);
+                if (length < 0) batch.done[g] = 2;
+            }
+            stats.solveSeconds += chrono::duration<double>(chrono::steady_clock::now() - solveStart).count();
+        }
+
+        int active = 0;
+        for (int g = 0; g < batch.count; g++) {
+            if (batch.done[g] == 1) finishGame(stats, gridSize, 0, true);
+            else if (batch.done[g] == 2) {
+                stats.games++;
+                stats.gaveUp++;
+            }
+            else active++;
+        }
+
+        chrono::steady_clock::time_point playStart = chrono::steady_clock::now();
+
+        for (int step = 0; step < config.maxMoves && active > 0; step++) {
+            for (int g = 0; g < batch.count; g++) {
+                if (batch.done[g]) continue;
+
+                int code = chooseMove(batch, target, g, config.policy);
+                int blank = batch.blank[g];
+                int next = blankAfterMove(blank, code, gridSize);
+                unsigned char* board = batch.tiles + g * cells;
+                int tile = board[next];
+
+                batch.manhattan[g] += manhattanChange(target, tile, next, blank);
+                board[blank] = tile;
+                board[next] = 0;
+                batch.blank[g] = next;
+                batch.lastMove[g] = code;
+                batch.moves[g]++;
+
+                if (batch.manhattan[g] == 0) {
+                    batch.done[g] = 1;
+                    finishGame(stats, gridSize, batch.moves[g], true);
+                    active--;
+                }
+            }
+        }
+
+        stats.playSeconds += chrono::duration<double>(chrono::steady_clock::now() - playStart).count();
+
+        // Games still unsolved at the move limit
+        for (int g = 0; g < batch.count; g++) {
+            stats.movesPlayed += batch.moves[g];
+            if (!batch.done[g]) finishGame(stats, gridSize, 0, false);
+        }
+    }
+}
+
+// Theme sizes that can appear on a grid size (the distributions do not depend on the theme)
+string themeSizesFor(int gridSize) {
+    string sizes = "";
+    for (int t = 0; t < NUM_THEMES; t++) {
+        if (themeSize(t) < gridSize * gridSize - 1) continue;
+        string size = to_string(themeSize(t));
+        if (sizes.find(size) != string::npos) continue;
+        sizes += (sizes == "" ? "" : "/") + size;
+    }
+    return sizes == "" ? "numbers" : sizes;
+}
+
+// Run one policy on one grid size across all threads and print a result row
+void runSimulation(SimConfig config, long long games, int threads) {
+    vector<SimStats> stats(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        long long share = games / threads + (t < games % threads ? 1 : 0);
+        workers.push_back(thread(simulateThread, config, share, (unsigned int)t, &stats[t]));
+    }
+    for (int t = 0; t < threads; t++) workers[t].join();
+
+    SimStats total;
+    for (int t = 0; t < threads; t++) total.merge(stats[t]);
+
+    double solvedShare = total.games > 0 ? 100.0 * total.solved / total.games : 0;
+    double perCore = total.playSeconds > 0 ? total.movesPlayed / total.playSeconds : 0;
+    cout << "  " << left << setw(8) << policyNames[config.policy] << right
+         << setw(10) << total.games
+         << setw(8) << fixed << setprecision(1) << solvedShare << "%";
+    if (config.policy == POLICY_HINT) cout << setw(8) << (total.games > 0 ? 100.0 * total.gaveUp / total.games : 0) << "%";
+    else cout << setw(9) << "-";
+    cout
+         << setw(9) << total.moves.getMean()
+         << setw(7) << total.moves.percentile(0.10)
+         << setw(7) << total.moves.percentile(0.50)
+         << setw(7) << total.moves.percentile(0.90)
+         << setw(7) << total.moves.percentile(0.99)
+         << setw(7) << total.scramble.percentile(0.50)
+         << setw(8) << (total.solved > 0 ? 100.0 * total.fiveStars / total.solved : 0) << "%"
+         << setw(8) << (total.solved > 0 ? 100.0 * total.fourStars / total.solved : 0) << "%"
+         << setw(12) << setprecision(2) << perCore / 1e6 << " M";
+    if (config.policy == POLICY_HINT && total.games > 0) {
+        cout << "   (IDA* " << setprecision(1) << total.solveSeconds * 1000 / total.games << " ms/board)";
+    }
+    cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    long long games = 100000;
+    long long hintGames = 1000;
+    int threads = thread::hardware_concurrency();
+    int maxSize = 5;
+    SimConfig config;
+    config.shuffleFactor = 20;
+    config.maxMoves = 5000;
+    config.hintBudget = 1000000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string arg = argv[i];
+        if (arg == "--games") games = atoll(argv[i + 1]);
+        else if (arg == "--threads") threads = atoi(argv[i + 1]);
+        else if (arg == "--max-size") maxSize = atoi(argv[i + 1]);
+        else if (arg == "--max-moves") config.maxMoves = atoi(argv[i + 1]);
+        else if (arg == "--shuffle-factor") config.shuffleFactor = atoi(argv[i + 1]);
+        else if (arg == "--hint-games") hintGames = atoll(argv[i + 1]);
+        else if (arg == "--hint-budget") config.hintBudget = atoll(argv[i + 1]);
+    }
+    if (threads < 1) threads = 1;
+    if (maxSize > 5) maxSize = 5;
+
+    cout << "Threads: " << threads << ", shuffles: gridSize^2 * " << config.shuffleFactor
+         << ", move limit: " << config.maxMoves << "\n";
+
+    for (int size = 3; size <= maxSize; size++) {
+        config.gridSize = size;
+        cout << "\n" << size << "x" << size << " (theme sizes " << themeSizesFor(size) << ")"
+             << ", 5 stars <= " << size * size * 3 << " moves, 4 stars <= " << size * size * 5 << "\n";
+        cout << "  " << left << setw(8) << "policy" << right << setw(10) << "games" << setw(9) << "solved" << setw(9) << "gave up"
+             << setw(9) << "mean" << setw(7) << "p10" << setw(7) << "p50" << setw(7) << "p90" << setw(7) << "p99" << setw(7) << "start"
+             << setw(9) << "5 stars" << setw(9) << "4 stars" << setw(14) << "moves/s/core" << "\n";
+
+        for (int p = 0; p < NUM_POLICIES; p++) {
+            config.policy = (Policy)p;
+            runSimulation(config, p == POLICY_HINT ? hintGames : games, threads);
+        }
+    }
+    return 0;
+}
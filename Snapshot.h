@@ -0,0 +1,187 @@
+// Snapshot: Compact save/resume format for a game in progress
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <fstream>
+#include "GameSession.h"
+using namespace std;
+
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER 15      // Bytes before the board
+
+// Layout (little endian):
+//   [0]      version
+//   [1..4]   seed (rebuilds theme and target pattern)
+//   [5]      theme
+//   [6]      grid size N
+//   [7]      blank position (row * N + col)
+//   [8..11]  move count
+//   [12..14] number of moves in history
+//   N*N bytes current board (tile IDs)
+//   history packed 4 moves per byte (2 bits each, oldest first)
+// A 4x4 game with 40 moves in history takes 41 bytes
+
+// Append an unsigned value as little endian bytes
+void putBytes(string& out, unsigned int value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out += (char)((value >> (8 * i)) & 0xFF);
+    }
+}
+
+// Read an unsigned little endian value
+unsigned int getBytes(const string& data, int pos, int bytes) {
+    unsigned int value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (unsigned int)(unsigned char)data[pos + i] << (8 * i);
+    }
+    return value;
+}
+
+// Map arrow key codes to 2-bit move codes and back
+int directionCode(char direction) {
+    if (direction == KEY_UP) return 0;
+    if (direction == KEY_DOWN) return 1;
+    if (direction == KEY_LEFT) return 2;
+    return 3;
+}
+
+char directionFromCode(int code) {
+    static const char keys[4] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT};
+    return keys[code & 3];
+}
+
+// Encode a game in progress
+string saveSnapshot(GameSession& game) {
+    string history = game.moveHistory.getDirections();
+    int cells = game.gridSize * game.gridSize;
+
+    string out;
+    out.reserve(SNAPSHOT_HEADER + cells + (history.length() + 3) / 4);
+
+    putBytes(out, SNAPSHOT_VERSION, 1);
+    putBytes(out, game.seed, 4);
+    putBytes(out, game.currentTheme, 1);
+    putBytes(out, game.gridSize, 1);
+    putBytes(out, game.emptyRow * game.gridSize + game.emptyCol, 1);
+    putBytes(out, game.moves, 4);
+    putBytes(out, history.length(), 3);
+
+    out.append((const char*)game.currentGrid.cells(), cells);
+
+    unsigned char packed = 0;
+    for (int i = 0; i < (int)history.length(); i++) {
+        packed |= directionCode(history[i]) << (2 * (i % 4));
+        if (i % 4 == 3) {
+            out += (char)packed;
+            packed = 0;
+        }
+    }
+    if (history.length() % 4 != 0) out += (char)packed;
+
+    return out;
+}
+
+// Move code i of the history stored at historyStart
+int historyCode(const string& data, int historyStart, int i) {
+    return ((unsigned char)data[historyStart + i / 4] >> (2 * (i % 4))) & 3;
+}
+
+// Check everything a snapshot claims before a game is built from it:
+// the board holds every tile ID exactly once with the empty space at 'blank',
+// and undoing the whole history keeps the empty space on the grid
+bool isValidSnapshot(const string& data) {
+    if ((int)data.length() < SNAPSHOT_HEADER) return false;
+    if (getBytes(data, 0, 1) != SNAPSHOT_VERSION) return false;
+
+    int gridSize = getBytes(data, 6, 1);
+    if (gridSize < MIN_GRID_SIZE || gridSize > MAX_GRID_SIZE) return false;
+
+    int cells = gridSize * gridSize;
+    int blank = getBytes(data, 7, 1);
+    int historyLength = getBytes(data, 12, 3);
+    if ((int)data.length() != SNAPSHOT_HEADER + cells + (historyLength + 3) / 4) return false;
+    if (blank >= cells || data[SNAPSHOT_HEADER + blank] != 0) return false;
+    unsigned int moves = getBytes(data, 8, 4);
+    if (moves < (unsigned int)historyLength || moves > 0x7FFFFFFF) return false;
+
+    bool seen[MAX_CELLS] = {false};
+    for (int i = 0; i < cells; i++) {
+        int tile = (unsigned char)data[SNAPSHOT_HEADER + i];
+        if (tile >= cells || seen[tile]) return false;
+        seen[tile] = true;
+    }
+
+    // Walk the empty space back through the history, newest move first
+    int row = blank / gridSize, col = blank % gridSize;
+    int historyStart = SNAPSHOT_HEADER + cells;
+    for (int i = historyLength - 1; i >= 0; i--) {
+        int code = historyCode(data, historyStart, i);
+        if (code == 0) row--;           // Undo of KEY_UP
+        else if (code == 1) row++;
+        else if (code == 2) col--;
+        else col++;
+        if (row < 0 || row >= gridSize || col < 0 || col >= gridSize) return false;
+    }
+    return true;
+}
+
+// Restore a game from a snapshot
+// Returns false (leaving the game untouched) if the data is invalid
+bool loadSnapshot(GameSession& game, const string& data) {
+    if (!isValidSnapshot(data)) return false;
+
+    int gridSize = getBytes(data, 6, 1);
+    int cells = gridSize * gridSize;
+    int blank = getBytes(data, 7, 1);
+    int historyLength = getBytes(data, 12, 3);
+
+    // The seed rebuilds the target pattern, so only the board is stored
+    GameSession pattern;
+    pattern.seed = getBytes(data, 1, 4);
+    pattern.gridSize = gridSize;
+    int selected[MAX_CELLS];
+    patternTiles(pattern, selected);
+    if (pattern.currentTheme != (int)getBytes(data, 5, 1)) return false;
+
+    game.seed = pattern.seed;
+    game.gridSize = gridSize;
+    buildPattern(game);
+
+    game.targetGrid = game.savedGrid;
+    game.currentGrid.resize(gridSize);
+    for (int c = 0; c < cells; c++) {
+        game.currentGrid.setTile(c, (unsigned char)data[SNAPSHOT_HEADER + c]);
+    }
+
+    game.emptyRow = blank / gridSize;
+    game.emptyCol = blank % gridSize;
+    game.moves = getBytes(data, 8, 4);
+
+    game.moveHistory.clear();
+    int historyStart = SNAPSHOT_HEADER + cells;
+    int firstMove = game.moves - historyLength;
+    for (int i = 0; i < historyLength; i++) {
+        game.moveHistory.push(directionFromCode(historyCode(data, historyStart, i)), firstMove + i + 1);
+    }
+    return true;
+}
+
+// Write a snapshot to a file
+bool saveSnapshotFile(GameSession& game, string filename) {
+    ofstream file(filename.c_str(), ios::binary);
+    if (!file.is_open()) return false;
+    string data = saveSnapshot(game);
+    file.write(data.data(), data.length());
+    return file.good();
+}
+
+// Read a snapshot from a file
+bool loadSnapshotFile(GameSession& game, string filename) {
+    ifstream file(filename.c_str(), ios::binary);
+    if (!file.is_open()) return false;
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    return loadSnapshot(game, data);
+}
+
+#endif
@@ -0,0 +1,270 @@
+// Solver: Solutions for packed boards (IDA* with the Manhattan distance)
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include "BoardEval.h"
+using namespace std;
+
+#define SOLVE_MAX_LENGTH 1024   // Longest solution the solvers can return (quick 5x5 solutions can be long)
+#define SOLVE_GAVE_UP -1        // Node budget ran out before a solution was found
+#define SOLVE_CANCELLED -2      // A newer request replaced this one
+#define SOLVE_CHECK_NODES 1024  // Nodes between checks for cancellation
+
+// Solution moves are coded like snapshot history: the arrow key that makes them
+//   0 = KEY_UP (empty space moves down), 1 = KEY_DOWN (up),
+//   2 = KEY_LEFT (right), 3 = KEY_RIGHT (left)
+// code ^ 1 is the opposite move
+
+// Row/column step of the empty space for each move code
+const int blankRowStep[4] = {1, -1, 0, 0};
+const int blankColStep[4] = {0, 0, 1, -1};
+
+// Arrow key of a move code
+char moveKey(int code) {
+    static const char keys[4] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT};
+    return keys[code & 3];
+}
+
+// Position of the empty space after a move (-1 if it would leave the grid)
+inline int blankAfterMove(int blank, int code, int gridSize) {
+    int row = blank / gridSize + blankRowStep[code];
+    int col = blank % gridSize + blankColStep[code];
+    if (row < 0 || row >= gridSize || col < 0 || col >= gridSize) return -1;
+    return row * gridSize + col;
+}
+
+// Change of the Manhattan distance when the tile at 'from' slides into 'to'
+inline int manhattanChange(const BoardTarget& target, int tile, int from, int to) {
+    int gridSize = target.gridSize;
+    int before = abs(from / gridSize - target.goalRow[tile]) + abs(from % gridSize - target.goalCol[tile]);
+    int after = abs(to / gridSize - target.goalRow[tile]) + abs(to % gridSize - target.goalCol[tile]);
+    return after - before;
+}
+
+// Search state shared by the recursive IDA* steps
+struct SolveSearch {
+    const BoardTarget* target;
+    unsigned char board[MAX_CELLS];
+    unsigned char path[SOLVE_MAX_LENGTH];
+    long long nodes;
+    long long nodeBudget;
+    int bound;
+    int nextBound;              // Smallest f that exceeded the bound
+    int length;                 // Moves in the solution once found
+    int weight;                 // f = depth + weight * distance (1 = optimal)
+    const atomic<unsigned int>* ticket;     // Cancelled once this differs from expectedTicket
+    unsigned int expectedTicket;
+    bool cancelled;
+    bool hasDeadline;
+    chrono::steady_clock::time_point deadline;  // Give up after this time
+};
+
+// Count an expanded node, checking now and then for cancellation and the deadline
+// Returns false once the search has to stop
+inline bool countNode(SolveSearch& s) {
+    if (++s.nodes > s.nodeBudget) return false;
+
+    if (s.nodes % SOLVE_CHECK_NODES == 0) {
+        if (s.ticket != NULL && s.ticket -> load(memory_order_relaxed) != s.expectedTicket) {
+            s.cancelled = true;
+            s.nodeBudget = 0;   // Unwinds the search like an exhausted budget
+            return false;
+        }
+        if (s.hasDeadline && chrono::steady_clock::now() >= s.deadline) {
+            s.nodeBudget = 0;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Depth-first search below the current bound (any grid size)
+// Returns true when the board is solved (the path holds the moves)
+bool searchBelow(SolveSearch& s, int blank, int depth, int distance, int lastMove) {
+    int f = depth + s.weight * distance;
+    if (f > s.bound) {
+        if (f < s.nextBound) s.nextBound = f;
+        return false;
+    }
+    if (distance == 0) {
+        s.length = depth;
+        return true;
+    }
+    if (depth >= SOLVE_MAX_LENGTH || !countNode(s)) return false;
+
+    for (int code = 0; code < 4; code++) {
+        if (code == (lastMove ^ 1)) continue;   // Never undo the previous move
+        int next = blankAfterMove(blank, code, s.target -> gridSize);
+        if (next < 0) continue;
+
+        int tile = s.board[next];
+        int change = manhattanChange(*s.target, tile, next, blank);
+        s.board[blank] = tile;
+        s.board[next] = 0;
+        s.path[depth] = code;
+
+        bool found = searchBelow(s, next, depth + 1, distance + change, code);
+
+        s.board[next] = tile;
+        s.board[blank] = 0;
+        if (found) return true;
+        if (s.nodes > s.nodeBudget) return false;
+    }
+    return false;
+}
+
+// SIZE-SPECIALIZED SEARCH
+// For the common grid sizes N is a template parameter: the move table, the board
+// and the distance loops have constant sizes the compiler can unroll, and a move
+// costs two table lookups instead of divisions. Other sizes use searchBelow()
+
+// Tables and board of one search on an N x N grid
+template <int N>
+struct FixedSearch {
+    signed char neighbour[N * N][4];        // Cell the empty space moves to by move code (-1 = off the grid)
+    unsigned char distance[N * N][N * N];   // distance[tile][cell]: Manhattan distance from cell to the tile's goal
+    unsigned char board[N * N];
+};
+
+// Fill the tables for a target and copy in the start board
+template <int N>
+void setFixedSearch(FixedSearch<N>& fixed, const BoardTarget& target, const unsigned char* board) {
+    for (int cell = 0; cell < N * N; cell++) {
+        for (int code = 0; code < 4; code++) fixed.neighbour[cell][code] = blankAfterMove(cell, code, N);
+        fixed.distance[0][cell] = 0;                // The empty space does not count
+        for (int tile = 1; tile < N * N; tile++) {
+            fixed.distance[tile][cell] = abs(cell / N - target.goalRow[tile]) + abs(cell % N - target.goalCol[tile]);
+        }
+        fixed.board[cell] = board[cell];
+    }
+}
+
+// Manhattan distance of the board being searched
+template <int N>
+int fixedDistance(const FixedSearch<N>& fixed) {
+    int sum = 0;
+    for (int cell = 0; cell < N * N; cell++) sum += fixed.distance[fixed.board[cell]][cell];
+    return sum;
+}
+
+// searchBelow() for an N x N grid
+template <int N>
+bool searchBelowFixed(SolveSearch& s, FixedSearch<N>& fixed, int blank, int depth, int distance, int lastMove) {
+    int f = depth + s.weight * distance;
+    if (f > s.bound) {
+        if (f < s.nextBound) s.nextBound = f;
+        return false;
+    }
+    if (distance == 0) {
+        s.length = depth;
+        return true;
+    }
+    if (depth >= SOLVE_MAX_LENGTH || !countNode(s)) return false;
+
+    for (int code = 0; code < 4; code++) {
+        if (code == (lastMove ^ 1)) continue;
+        int next = fixed.neighbour[blank][code];
+        if (next < 0) continue;
+
+        int tile = fixed.board[next];
+        int change = fixed.distance[tile][blank] - fixed.distance[tile][next];
+        fixed.board[blank] = tile;
+        fixed.board[next] = 0;
+        s.path[depth] = code;
+
+        bool found = searchBelowFixed<N>(s, fixed, next, depth + 1, distance + change, code);
+
+        fixed.board[next] = tile;
+        fixed.board[blank] = 0;
+        if (found) return true;
+        if (s.nodes > s.nodeBudget) return false;
+    }
+    return false;
+}
+
+// Iterative deepening: raises the bound to the smallest f that was cut off until a solution fits
+// search() runs one depth-first pass from the start board
+template <typename Search>
+int deepen(SolveSearch& s, int distance, Search search, unsigned char* path) {
+    int maxBound = SOLVE_MAX_LENGTH * s.weight;
+    s.bound = s.weight * distance;
+    while (s.bound <= maxBound) {
+        s.nextBound = maxBound + 1;
+        if (search()) {
+            if (path != NULL) memcpy(path, s.path, s.length);
+            return s.length;
+        }
+        if (s.nodes > s.nodeBudget) break;
+        s.bound = s.nextBound;
+    }
+    return s.cancelled ? SOLVE_CANCELLED : SOLVE_GAVE_UP;
+}
+
+// Prepare the tables and run the search on an N x N grid
+template <int N>
+int runSearchFixed(SolveSearch& s, const unsigned char* board, int blank, unsigned char* path) {
+    FixedSearch<N> fixed;
+    setFixedSearch<N>(fixed, *s.target, board);
+    int distance = fixedDistance<N>(fixed);
+    return deepen(s, distance, [&] { return searchBelowFixed<N>(s, fixed, blank, 0, distance, 4); }, path);
+}
+
+// Run iterative deepening on a prepared search
+// specialized: use the fixed-size search for 3x3, 4x4 and 5x5 (false = general code for every size)
+int runSearch(SolveSearch& s, const unsigned char* board, unsigned char* path, bool specialized = true) {
+    s.nodes = 0;
+    s.cancelled = false;
+
+    int blank = 0;
+    while (board[blank] != 0) blank++;
+
+    if (specialized) {
+        switch (s.target -> gridSize) {
+            case 3: return runSearchFixed<3>(s, board, blank, path);
+            case 4: return runSearchFixed<4>(s, board, blank, path);
+            case 5: return runSearchFixed<5>(s, board, blank, path);
+        }
+    }
+
+    memcpy(s.board, board, s.target -> cells);
+    int misplaced, distance;
+    evaluateBoard(*s.target, board, misplaced, distance);
+    return deepen(s, distance, [&] { return searchBelow(s, blank, 0, distance, 4); }, path);
+}
+
+// Find a shortest solution of a board
+// Writes the move codes into path (SOLVE_MAX_LENGTH bytes) if it is not NULL
+// Returns the number of moves, or SOLVE_GAVE_UP after nodeBudget expanded nodes
+// If ticket is given the search stops with SOLVE_CANCELLED once *ticket != expectedTicket
+int solveBoard(const BoardTarget& target, const unsigned char* board, long long nodeBudget, unsigned char* path,
+               const atomic<unsigned int>* ticket = NULL, unsigned int expectedTicket = 0) {
+    SolveSearch s;
+    s.target = &target;
+    s.nodeBudget = nodeBudget;
+    s.weight = 1;
+    s.ticket = ticket;
+    s.expectedTicket = expectedTicket;
+    s.hasDeadline = false;
+    return runSearch(s, board, path);
+}
+
+// Find a solution within a time limit
+// weight > 1 trades optimality for speed (the result is at most weight times too long)
+// Returns the number of moves, or SOLVE_GAVE_UP if the time ran out
+int solveBoardWithin(const BoardTarget& target, const unsigned char* board, int weight, int milliseconds,
+                     unsigned char* path) {
+    SolveSearch s;
+    s.target = &target;
+    s.nodeBudget = 1LL << 62;
+    s.weight = weight;
+    s.ticket = NULL;
+    s.expectedTicket = 0;
+    s.hasDeadline = true;
+    s.deadline = chrono::steady_clock::now() + chrono::milliseconds(milliseconds);
+    return runSearch(s, board, path);
+}
+
+#endif
@@ -0,0 +1,42 @@
+// SPSC Queue: Lock-free queue between one producer thread and one consumer thread
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+using namespace std;
+
+// Single-producer single-consumer ring buffer without locks
+// One thread may push and one other thread may pop at the same time
+template <typename T, int Capacity>
+class SpscQueue {
+    T items[Capacity];
+    atomic<unsigned int> head;      // Next item to pop (written by the consumer)
+    atomic<unsigned int> tail;      // Next free slot (written by the producer)
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Add an item (returns false if the queue is full)
+    bool push(const T& item) {
+        unsigned int t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == Capacity) return false;
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // Take the oldest item (returns false if the queue is empty)
+    bool pop(T& item) {
+        unsigned int h = head.load(memory_order_relaxed);
+        if (h == tail.load(memory_order_acquire)) return false;
+        item = items[h & (Capacity - 1)];
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() {
+        return head.load(memory_order_acquire) == tail.load(memory_order_acquire);
+    }
+};
+
+#endif
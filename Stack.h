@@ -2,6 +2,10 @@
 #ifndef STACK_H
 #define STACK_H
 
+#include <string>
+#include "NodePool.h"
+using namespace std;
+
 // Used to store move history for undo functionality
 struct StackNode {
     char direction;     // Arrow key code (72=Up, 80=Down, 75=Left, 77=Right)
@@ -14,6 +18,7 @@ struct StackNode {
 class Stack {
     StackNode* top;  
     int count;
+    NodePool<StackNode, 64> pool;     // Node storage
 
 public:
     Stack() : top(NULL), count(0) {}
@@ -22,9 +27,13 @@ public:
         clear();
     }
 
+    // Nodes live in this stack's pool, so a stack cannot be copied
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+
     // Add a move to history
     void push(char direction, int moveNum) {
-        StackNode* newNode = new StackNode();
+        StackNode* newNode = pool.allocate();
         newNode -> direction = direction;
         newNode -> moveNum = moveNum;
         newNode -> next = top;
@@ -41,7 +50,7 @@ public:
         StackNode* temp = top;
         char direction = top -> direction;
         top = top -> next;
-        delete temp;
+        pool.release(temp);
         count--;
         return direction;
     }
@@ -56,11 +65,29 @@ public:
         return count;
     }
     
-    // Remove all moves from history
-    void clear() {
-        while (!isEmpty()) {
-            pop();
+    // Get all directions in history, oldest move first (used for saving)
+    string getDirections() {
+        string directions(count, ' ');
+        int index = count - 1;
+        StackNode* current = top;
+        while (current != NULL) {
+            directions[index--] = current -> direction;
+            current = current -> next;
         }
+        return directions;
+    }
+    
+    // Remove all moves from history (their memory is kept for the next round)
+    void clear() {
+        pool.reset();
+        top = NULL;
+        count = 0;
+    }
+
+    // Remove all moves and free their memory
+    void shrink() {
+        clear();
+        pool.releaseAll();
     }
 };
 
@@ -0,0 +1,40 @@
+// Themes: Emoji sets used to fill the puzzle grid
+#ifndef THEMES_H
+#define THEMES_H
+
+#include <string>
+using namespace std;
+
+#define NUM_THEMES 5            // Emoji themes in emojis[][]
+#define NUMBERS_THEME 5         // Numbered tiles for grids larger than any emoji theme
+
+string themes[] = {"Emotion", "Fruits", "Moon Phases", "Foods", "Animals", "Numbers"};
+
+string emojis[NUM_THEMES][25] = {
+    {"😙", "😆", "😑", "😮", "😢", "🤨", "🤪", "😍", "🙃",
+     "😧", "😁", "😷", "😌", "😱", "😤", "😶", "😨", "😭",
+     "🤭", "🤤", "🤮", "🤒", "🙄", "😋", "🤩"},
+
+    {"🍋", "🍈", "🍐", "🥕", "🍒", "🌶️", "🍏", "🥝", 
+     "🥑", "🍆", "🥭", "🥒", "🌽", "🍍", "🍌", "🍇", 
+     "🌰", "🍅", "🍓", "🍊", "🥥", "🍎", "🍉", "🍑"},
+
+    {"🌑", "🌒", "🌓", "🌕", "🌖", "🌗", "🌘", "🌔", "🌙"},
+
+    {"🥪", "🥔", "🍪", "🍩", "🍤", "🥜", "🍞", "🍮", 
+     "🥐", "🥖", "🌮", "🍝", "🥞", "🍰", "🥧", "🍦", 
+     "🥠", "🍔", "🌭", "🥨", "🍕", "🥘", "🍗", "🍟"},
+
+    {"🦇", "🐫", "🦔", "🐒", "🐅", "🐿️", "🦕", "🦅", 
+     "🐂", "🦈", "🐧", "🐕", "🐎", "🦌", "🐆", "🐖", 
+     "🦒", "🐃", "🦉", "🦃", "🐀", "🐡", "🐌", "🦍", "🐻"}
+};
+
+// Count how many emojis a theme has
+int themeSize(int theme) {
+    int count = 0;
+    while (count < 25 && emojis[theme][count] != "") count++;
+    return count;
+}
+
+#endif
@@ -2,48 +2,24 @@
 #include <cstdlib>
 #include <ctime>
 #include <windows.h>
-#include "DoublyLinkedList.h"
+#include "Grid.h"
 #include "Stack.h"
 #include "BST.h"
 #include "Display.h"
+#include "GlyphAtlas.h"
+#include "Themes.h"
+#include "GameSession.h"
+#include "Snapshot.h"
+#include "Profiler.h"
 #include "GameFunctions.h"
 
 using namespace std;
 
 // GLOBAL VARIABLES
-DoublyLinkedList currentGrid;       // Current puzzle state (what player sees)
-DoublyLinkedList targetGrid;        // Target pattern to match
-DoublyLinkedList savedGrid;         // Saved initial pattern (for retry)
-Stack moveHistory;                  // History of moves (for undo)
+// (per-game state lives in a GameSession, see GameSession.h)
 BST leaderboard;                    // High scores storage
 
-// Game state variables
-int gridSize = 3;                   // Current grid dimension (3, 4, or 5)
-int emptyRow = 0, emptyCol = 0;     // Position of empty space
-int moves = 0;                      // Current move count
-int currentTheme = 0;               // Current theme index
-
-string themes[] = {"Emotion", "Fruits", "Moon Phases", "Foods", "Animals"};
-
-string emojis[5][25] = {
-    {"😙", "😆", "😑", "😮", "😢", "🤨", "🤪", "😍", "🙃",
-     "😧", "😁", "😷", "😌", "😱", "😤", "😶", "😨", "😭",
-     "🤭", "🤤", "🤮", "🤒", "🙄", "😋", "🤩"},
-
-    {"🍋", "🍈", "🍐", "🥕", "🍒", "🌶️", "🍏", "🥝", 
-     "🥑", "🍆", "🥭", "🥒", "🌽", "🍍", "🍌", "🍇", 
-     "🌰", "🍅", "🍓", "🍊", "🥥", "🍎", "🍉", "🍑"},
-
-    {"🌑", "🌒", "🌓", "🌕", "🌖", "🌗", "🌘", "🌔", "🌙"},
-
-    {"🥪", "🥔", "🍪", "🍩", "🍤", "🥜", "🍞", "🍮", 
-     "🥐", "🥖", "🌮", "🍝", "🥞", "🍰", "🥧", "🍦", 
-     "🥠", "🍔", "🌭", "🥨", "🍕", "🥘", "🍗", "🍟"},
-
-    {"🦇", "🐫", "🦔", "🐒", "🐅", "🐿️", "🦕", "🦅", 
-     "🐂", "🦈", "🐧", "🐕", "🐎", "🦌", "🐆", "🐖", 
-     "🦒", "🐃", "🦉", "🦃", "🐀", "🐡", "🐌", "🦍", "🐻"}
-};
+GlyphAtlas glyphAtlas[NUM_THEMES + 1];  // Pre-rendered cells per theme (+ numbered tiles)
 
 
 int main() {
@@ -52,8 +28,14 @@ int main() {
     // Seed random number generator for shuffling
     srand(time(0));
 
-    // Load saved high scores from file
-    leaderboard.loadFromFile("leaderboard.txt");
+    // Pre-render every theme's grid cells once
+    buildGlyphAtlases();
+
+    // Open saved high scores (read when first needed, see BST::openLazy)
+    {
+        ScopedTimer timer(PROBE_LEADERBOARD_IO);
+        leaderboard.openLazy("leaderboard.txt");
+    }
 
     // Show tutorial/controls screen
     showSplash();
@@ -68,9 +50,13 @@ int main() {
             break;
         } else if (choice == 4) {
             displayLeaderboard();       // View Leaderboard
-        } else if (choice >= 1 && choice <= 3) {
+        } else if (choice == 7) {
+            playRace();                 // Race the computer
+        } else if ((choice >= 1 && choice <= 3) || choice >= 5) {
             playGame(choice);           // Start game with selected difficulty
         }
     }
+
+    dumpProfile(PROFILE_FILE);          // Only writes when built with -DEMOSHIFT_PROFILE
     return 0;
 }
\ No newline at end of file